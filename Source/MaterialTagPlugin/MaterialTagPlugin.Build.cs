@@ -16,7 +16,7 @@ public class MaterialTagPlugin : ModuleRules
 			}
 		);
 		
-		// Editor-only modules for property customization
+		// Editor-only modules for property customization and the commandlets
 		if (Target.bBuildEditor)
 		{
 			PrivateDependencyModuleNames.AddRange(
@@ -26,7 +26,11 @@ public class MaterialTagPlugin : ModuleRules
 					"SlateCore",
 					"InputCore",
 					"PropertyEditor",
-					"UnrealEd"
+					"UnrealEd",
+					"DirectoryWatcher",
+					"AssetRegistry",
+					"WorkspaceMenuStructure",
+					"Json"
 				}
 			);
 		}
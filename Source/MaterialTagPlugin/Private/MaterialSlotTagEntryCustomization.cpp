@@ -39,9 +39,9 @@ void FMaterialSlotTagEntryCustomization::CustomizeHeader(TSharedRef<IPropertyHan
 		.NameContent()
 		[
 			SNew(STagDropTarget)
-			.OnTagDropped_Lambda([Self](const FString& TagName)
+			.OnTagDropped_Lambda([Self](const FGameplayTag& Tag)
 			{
-				Self->AddTagToSlot(TagName);
+				Self->AddTagToSlot(Tag);
 			})
 			[
 				SNew(STextBlock)
@@ -52,9 +52,9 @@ void FMaterialSlotTagEntryCustomization::CustomizeHeader(TSharedRef<IPropertyHan
 		.MinDesiredWidth(300.0f)
 		[
 			SNew(STagDropTarget)
-			.OnTagDropped_Lambda([Self](const FString& TagName)
+			.OnTagDropped_Lambda([Self](const FGameplayTag& Tag)
 			{
-				Self->AddTagToSlot(TagName);
+				Self->AddTagToSlot(Tag);
 			})
 			[
 				TagPillBox.ToSharedRef()
@@ -107,8 +107,6 @@ void FMaterialSlotTagEntryCustomization::RebuildTagPills()
 		TagNameHandle->GetValue(TagFName);
 		if (TagFName.IsNone()) continue;
 
-		FString TagStr = TagFName.ToString();
-
 		TagPillBox->AddSlot()
 		.AutoHeight()
 		.Padding(1.0f)
@@ -118,8 +116,8 @@ void FMaterialSlotTagEntryCustomization::RebuildTagPills()
 			.AutoWidth()
 			[
 				SNew(SRemovableTagPill)
-				.TagName(TagStr)
-				.OnRemove_Lambda([Self](const FString& RemovedTag)
+				.TagName(TagFName)
+				.OnRemove_Lambda([Self](FName RemovedTag)
 				{
 					Self->RemoveTagFromSlot(RemovedTag);
 				})
@@ -149,16 +147,12 @@ FText FMaterialSlotTagEntryCustomization::GetSlotDisplayName() const
 	return FText::FromString(SlotStr);
 }
 
-void FMaterialSlotTagEntryCustomization::AddTagToSlot(const FString& TagName)
+void FMaterialSlotTagEntryCustomization::AddTagToSlot(const FGameplayTag& Tag)
 {
-	if (!TagsHandle.IsValid()) return;
+	// Pills only hand out tags that resolved when the preset was loaded
+	if (!TagsHandle.IsValid() || !Tag.IsValid()) return;
 
-	FGameplayTag Tag = FGameplayTag::RequestGameplayTag(FName(*TagName), false);
-	if (!Tag.IsValid())
-	{
-		UE_LOG(LogTemp, Warning, TEXT("MaterialSlotTagEntry: Tag '%s' not found"), *TagName);
-		return;
-	}
+	const FName TagName = Tag.GetTagName();
 
 	TSharedPtr<IPropertyHandleArray> ArrayHandle = TagsHandle->AsArray();
 	if (!ArrayHandle.IsValid()) return;
@@ -177,7 +171,7 @@ void FMaterialSlotTagEntryCustomization::AddTagToSlot(const FString& TagName)
 			{
 				FName ExistingTagName;
 				TagNameHandle->GetValue(ExistingTagName);
-				if (ExistingTagName == FName(*TagName)) return;
+				if (ExistingTagName == TagName) return;
 			}
 		}
 	}
@@ -196,7 +190,7 @@ void FMaterialSlotTagEntryCustomization::AddTagToSlot(const FString& TagName)
 		TSharedPtr<IPropertyHandle> TagNameFieldHandle = TagFieldHandle->GetChildHandle(TEXT("TagName"));
 		if (TagNameFieldHandle.IsValid())
 		{
-			TagNameFieldHandle->SetValue(FName(*TagName));
+			TagNameFieldHandle->SetValue(TagName);
 		}
 	}
 
@@ -206,7 +200,7 @@ void FMaterialSlotTagEntryCustomization::AddTagToSlot(const FString& TagName)
 	}
 }
 
-void FMaterialSlotTagEntryCustomization::RemoveTagFromSlot(const FString& TagName)
+void FMaterialSlotTagEntryCustomization::RemoveTagFromSlot(FName TagName)
 {
 	if (!TagsHandle.IsValid()) return;
 
@@ -227,7 +221,7 @@ void FMaterialSlotTagEntryCustomization::RemoveTagFromSlot(const FString& TagNam
 
 		FName ExistingTagName;
 		TagNameHandle->GetValue(ExistingTagName);
-		if (ExistingTagName == FName(*TagName))
+		if (ExistingTagName == TagName)
 		{
 			FScopedTransaction Transaction(LOCTEXT("RemoveTag", "Remove Tag"));
 			ArrayHandle->DeleteItem(i);
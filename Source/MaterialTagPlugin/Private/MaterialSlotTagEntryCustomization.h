@@ -28,11 +28,11 @@ private:
 	/** Get the slot name from the property handle (delegate-bound) */
 	FText GetSlotDisplayName() const;
 
-	/** Add a gameplay tag by name to this slot's GameplayTags array */
-	void AddTagToSlot(const FString& TagName);
+	/** Add a gameplay tag to this slot's GameplayTags array */
+	void AddTagToSlot(const FGameplayTag& Tag);
 
 	/** Remove a gameplay tag by name from this slot's GameplayTags array */
-	void RemoveTagFromSlot(const FString& TagName);
+	void RemoveTagFromSlot(FName TagName);
 
 	/** Rebuild the pill widgets in the tag box */
 	void RebuildTagPills();
@@ -0,0 +1,167 @@
+#include "MaterialTagApplyCommandlet.h"
+
+#if WITH_EDITOR
+#include "MaterialTagAssetPipeline.h"
+#include "MaterialTagAssetUserData.h"
+#include "MaterialTagPresetDatabase.h"
+#include "Engine/SkeletalMesh.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+	enum class EApplyResult : uint8
+	{
+		Tagged,
+		Unchanged,
+		NoMatch,
+		/** No preset match, but existing entries were reconciled with the mesh's slots and need saving */
+		Reconciled,
+	};
+
+	EApplyResult ApplyToMesh(USkeletalMesh& Mesh, FMaterialTagPresetDatabase& Database)
+	{
+		const FString MeshName = Mesh.GetName();
+
+		// Entries reconciled here or in PostLoad (legacy data without a stored slot layout, or a changed mesh)
+		// are saved even when no preset applies, so later loads skip the merge
+		UMaterialTagAssetUserData* UserData = Mesh.GetAssetUserData<UMaterialTagAssetUserData>();
+		bool bModified = false;
+		if (UserData)
+		{
+			UserData->EnsureAllSlotsPopulated();
+			bModified = UserData->HasReconciledSlotsSinceLoad();
+		}
+
+		const TArray<FMaterialTagPresetCandidate> Candidates = Database.RankPresets(MeshName, 1);
+		if (Candidates.Num() == 0 || Candidates[0].Score < FMaterialTagPresetDatabase::AutoMatchConfidence)
+		{
+			UE_LOG(LogTemp, Log, TEXT("MaterialTagApplyCommandlet: No preset matches '%s' with enough confidence (best: '%s', %.2f)"),
+				*MeshName, Candidates.Num() > 0 ? *Candidates[0].Name : TEXT(""), Candidates.Num() > 0 ? Candidates[0].Score : 0.0f);
+			return bModified ? EApplyResult::Reconciled : EApplyResult::NoMatch;
+		}
+
+		const TSharedPtr<const FMaterialTagPreset> Preset = Database.FindPreset(Candidates[0].Name);
+		if (!Preset.IsValid())
+		{
+			return bModified ? EApplyResult::Reconciled : EApplyResult::NoMatch;
+		}
+
+		if (!UserData)
+		{
+			UserData = NewObject<UMaterialTagAssetUserData>(&Mesh);
+			Mesh.AddAssetUserData(UserData);
+			UserData->EnsureAllSlotsPopulated();
+			bModified = true;
+		}
+
+		if (!UserData->PresetMeshName.Equals(Preset->Name, ESearchCase::CaseSensitive))
+		{
+			UserData->PresetMeshName = Preset->Name;
+			bModified = true;
+		}
+
+		bModified |= UserData->ApplyPresetTags(*Preset) > 0;
+
+		if (!bModified)
+		{
+			return EApplyResult::Unchanged;
+		}
+
+		UserData->UpdatePresetInfo();
+		UE_LOG(LogTemp, Verbose, TEXT("MaterialTagApplyCommandlet: Tagged '%s' from preset '%s' (%.2f)"), *MeshName, *Preset->Name, Candidates[0].Score);
+		return EApplyResult::Tagged;
+	}
+}
+#endif
+
+UMaterialTagApplyCommandlet::UMaterialTagApplyCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Add or update material slot tags on every skeletal mesh under a content path from the preset database");
+	HelpUsage = TEXT("-run=MaterialTagApply -Path=/Game/Characters [-DryRun] [-MaxInFlight=32] [-BatchSize=64]");
+}
+
+int32 UMaterialTagApplyCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString ContentPath;
+	if (!FParse::Value(*Params, TEXT("Path="), ContentPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("MaterialTagApplyCommandlet: Missing -Path. Usage: %s"), *HelpUsage);
+		return 1;
+	}
+
+	const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+	int32 MaxInFlight = 32;
+	FParse::Value(*Params, TEXT("MaxInFlight="), MaxInFlight);
+	int32 BatchSize = 64;
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+
+	FMaterialTagPresetDatabase& Database = FMaterialTagPresetDatabase::Get();
+	if (!Database.HasPresetFile())
+	{
+		UE_LOG(LogTemp, Error, TEXT("MaterialTagApplyCommandlet: No preset file at %s"), *FMaterialTagPresetDatabase::GetPresetIniPath());
+		return 1;
+	}
+
+	// Index the presets and build the match index before the first mesh arrives
+	const double PresetStartTime = FPlatformTime::Seconds();
+	const int32 NumPresets = Database.WarmUp();
+	UE_LOG(LogTemp, Display, TEXT("MaterialTagApplyCommandlet: %d preset(s) indexed in %.2fs"), NumPresets, FPlatformTime::Seconds() - PresetStartTime);
+
+	FMaterialTagAssetPipeline Pipeline(MaxInFlight, BatchSize, !bDryRun);
+	const TArray<FName> PackageNames = Pipeline.FindPackages(ContentPath, USkeletalMesh::StaticClass());
+	UE_LOG(LogTemp, Display, TEXT("MaterialTagApplyCommandlet: %d skeletal mesh package(s) under %s%s"),
+		PackageNames.Num(), *ContentPath, bDryRun ? TEXT(" (dry run)") : TEXT(""));
+
+	int32 NumTagged = 0;
+	int32 NumUnchanged = 0;
+	int32 NumNoMatch = 0;
+	int32 NumReconciled = 0;
+	const bool bSuccess = Pipeline.Run(PackageNames, [&](UPackage& Package)
+	{
+		TArray<UObject*> Objects;
+		GetObjectsWithPackage(&Package, Objects, false);
+
+		bool bModified = false;
+		for (UObject* Object : Objects)
+		{
+			USkeletalMesh* Mesh = Cast<USkeletalMesh>(Object);
+			if (!Mesh) continue;
+
+			switch (ApplyToMesh(*Mesh, Database))
+			{
+			case EApplyResult::Tagged:
+				NumTagged++;
+				bModified = true;
+				break;
+			case EApplyResult::Unchanged:
+				NumUnchanged++;
+				break;
+			case EApplyResult::NoMatch:
+				NumNoMatch++;
+				break;
+			case EApplyResult::Reconciled:
+				NumNoMatch++;
+				NumReconciled++;
+				bModified = true;
+				break;
+			}
+		}
+		return bModified;
+	});
+
+	Pipeline.LogTimings(TEXT("MaterialTagApplyCommandlet"));
+	UE_LOG(LogTemp, Display, TEXT("MaterialTagApplyCommandlet: %d mesh(es) %s, %d already up to date, %d without a confident preset match (%d of them with slot entries %s)"),
+		NumTagged, bDryRun ? TEXT("would be tagged") : TEXT("tagged"), NumUnchanged, NumNoMatch, NumReconciled, bDryRun ? TEXT("to reconcile") : TEXT("reconciled"));
+
+	return bSuccess ? 0 : 1;
+#else
+	return 1;
+#endif
+}
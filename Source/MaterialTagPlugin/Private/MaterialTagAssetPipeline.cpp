@@ -0,0 +1,173 @@
+#include "MaterialTagAssetPipeline.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/ARFilter.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
+
+FMaterialTagAssetPipeline::FMaterialTagAssetPipeline(int32 InMaxInFlight, int32 InBatchSize, bool bInSave)
+	: MaxInFlight(FMath::Max(InMaxInFlight, 1))
+	, BatchSize(FMath::Max(InBatchSize, 1))
+	, bSave(bInSave)
+{
+}
+
+TArray<FName> FMaterialTagAssetPipeline::FindPackages(const FString& ContentPath, const UClass* Class)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.ScanPathsSynchronous({ ContentPath });
+
+	FARFilter Filter;
+	Filter.PackagePaths.Add(FName(*ContentPath));
+	Filter.bRecursivePaths = true;
+	Filter.ClassPaths.Add(Class->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	TArray<FName> PackageNames;
+	PackageNames.Reserve(Assets.Num());
+	TSet<FName> SeenPackages;
+	SeenPackages.Reserve(Assets.Num());
+	for (const FAssetData& Asset : Assets)
+	{
+		bool bAlreadySeen = false;
+		SeenPackages.Add(Asset.PackageName, &bAlreadySeen);
+		if (!bAlreadySeen)
+		{
+			PackageNames.Add(Asset.PackageName);
+		}
+	}
+
+	// Registry order is arbitrary; sorted paths keep neighbouring packages together on disk and logs reproducible
+	PackageNames.Sort(FNameLexicalLess());
+
+	FindSeconds += FPlatformTime::Seconds() - StartTime;
+	return PackageNames;
+}
+
+bool FMaterialTagAssetPipeline::Run(const TArray<FName>& PackageNames, FVisitor Visitor)
+{
+	const double RunStartTime = FPlatformTime::Seconds();
+
+	// Filled by the load callbacks, which fire on the game thread whenever async loading is ticked, including
+	// from inside the visitor or SavePackage. Held strongly so a collection before the visit can't free them.
+	TArray<TStrongObjectPtr<UPackage>> Loaded;
+	int32 NumInFlight = 0;
+	int32 NextPackage = 0;
+	bool bSuccess = true;
+
+	while (NextPackage < PackageNames.Num() || NumInFlight > 0 || Loaded.Num() > 0)
+	{
+		// Keep the loader ahead of the visitor
+		while (NumInFlight < MaxInFlight && NextPackage < PackageNames.Num())
+		{
+			NumInFlight++;
+			LoadPackageAsync(PackageNames[NextPackage++].ToString(), FLoadPackageAsyncDelegate::CreateLambda(
+				[this, &Loaded, &NumInFlight](const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result)
+				{
+					NumInFlight--;
+					if (Result == EAsyncLoadingResult::Succeeded && Package)
+					{
+						Loaded.Emplace(Package);
+					}
+					else
+					{
+						NumLoadFailed++;
+						UE_LOG(LogTemp, Error, TEXT("MaterialTagAssetPipeline: Could not load '%s'"), *PackageName.ToString());
+					}
+				}));
+		}
+
+		// Only block when there is nothing left to visit
+		const double LoadStartTime = FPlatformTime::Seconds();
+		while (Loaded.Num() == 0 && NumInFlight > 0)
+		{
+			ProcessAsyncLoading(true, false, 0.01);
+		}
+		LoadWaitSeconds += FPlatformTime::Seconds() - LoadStartTime;
+
+		// The visitor may flush async loading, which would append to Loaded mid-iteration
+		TArray<TStrongObjectPtr<UPackage>> Visiting = MoveTemp(Loaded);
+		Loaded.Reset();
+
+		const double VisitStartTime = FPlatformTime::Seconds();
+		for (const TStrongObjectPtr<UPackage>& Package : Visiting)
+		{
+			NumLoaded++;
+			if (Visitor(*Package) && bSave)
+			{
+				PendingSave.Add(Package.Get());
+			}
+		}
+		VisitSeconds += FPlatformTime::Seconds() - VisitStartTime;
+
+		// Release the visited packages so the next collection can free them; anything still in Loaded stays referenced
+		NumVisitedSinceFlush += Visiting.Num();
+		Visiting.Reset();
+		if (NumVisitedSinceFlush >= BatchSize || PendingSave.Num() >= BatchSize)
+		{
+			bSuccess &= Flush();
+		}
+	}
+
+	bSuccess &= Flush();
+
+	TotalSeconds += FPlatformTime::Seconds() - RunStartTime;
+	return bSuccess && NumLoadFailed == 0;
+}
+
+bool FMaterialTagAssetPipeline::Flush()
+{
+	bool bSuccess = true;
+
+	const double SaveStartTime = FPlatformTime::Seconds();
+	for (UPackage* Package : PendingSave)
+	{
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(),
+			Package->ContainsMap() ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension());
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_NoError;
+		if (UPackage::SavePackage(Package, nullptr, *Filename, SaveArgs))
+		{
+			NumSaved++;
+		}
+		else
+		{
+			NumSaveFailed++;
+			bSuccess = false;
+			UE_LOG(LogTemp, Error, TEXT("MaterialTagAssetPipeline: Could not save '%s' (read-only or checked in?)"), *Filename);
+		}
+	}
+	PendingSave.Reset();
+	SaveSeconds += FPlatformTime::Seconds() - SaveStartTime;
+
+	const double GCStartTime = FPlatformTime::Seconds();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	GCSeconds += FPlatformTime::Seconds() - GCStartTime;
+	NumVisitedSinceFlush = 0;
+
+	return bSuccess;
+}
+
+void FMaterialTagAssetPipeline::LogTimings(const TCHAR* Owner) const
+{
+	const double PackagesPerMinute = TotalSeconds > 0.0 ? NumLoaded * 60.0 / TotalSeconds : 0.0;
+
+	UE_LOG(LogTemp, Display, TEXT("%s: %d package(s) loaded, %d failed to load, %d saved, %d failed to save"),
+		Owner, NumLoaded, NumLoadFailed, NumSaved, NumSaveFailed);
+	UE_LOG(LogTemp, Display, TEXT("%s: find %.2fs, load wait %.2fs, process %.2fs, save %.2fs, GC %.2fs, total %.2fs (%.0f packages/min)"),
+		Owner, FindSeconds, LoadWaitSeconds, VisitSeconds, SaveSeconds, GCSeconds, FindSeconds + TotalSeconds, PackagesPerMinute);
+}
+
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+
+class UClass;
+class UPackage;
+
+/**
+ * Load/visit/save loop shared by the material tag commandlets.
+ *
+ * Packages are requested with LoadPackageAsync and the loader is kept MaxInFlight packages ahead,
+ * so it reads and deserializes the next packages while the game thread visits the ones that
+ * already finished. Packages the visitor modified are saved in batches; every batch ends with a
+ * garbage collection so memory stays flat over folders with thousands of meshes. Packages that
+ * finish loading are referenced until they have been visited, so those collections can run while
+ * loads are still in flight.
+ *
+ * Time spent in each stage is accumulated and reported by LogTimings.
+ */
+class FMaterialTagAssetPipeline
+{
+public:
+	/** Called on the game thread for each loaded package. Returns true if the package was modified and should be saved. */
+	using FVisitor = TFunctionRef<bool(UPackage& Package)>;
+
+	/**
+	 * InMaxInFlight: outstanding LoadPackageAsync requests.
+	 * InBatchSize: packages visited between garbage collections, and modified packages per save batch.
+	 * bInSave: false for dry runs and read-only passes; modified packages are then left unsaved.
+	 */
+	FMaterialTagAssetPipeline(int32 InMaxInFlight, int32 InBatchSize, bool bInSave);
+
+	/** Package names of every asset of Class (or a subclass) under ContentPath, e.g. "/Game/Characters". Scans the path first. */
+	TArray<FName> FindPackages(const FString& ContentPath, const UClass* Class);
+
+	/** Load and visit every package. Returns false if any package failed to load or save. */
+	bool Run(const TArray<FName>& PackageNames, FVisitor Visitor);
+
+	/** Log counts and per-stage timing, prefixed with Owner */
+	void LogTimings(const TCHAR* Owner) const;
+
+private:
+	/** Save the modified packages collected so far, then collect garbage */
+	bool Flush();
+
+	int32 MaxInFlight;
+	int32 BatchSize;
+	bool bSave;
+
+	/** Modified packages waiting for the next Flush */
+	TArray<UPackage*> PendingSave;
+	int32 NumVisitedSinceFlush = 0;
+
+	int32 NumLoaded = 0;
+	int32 NumLoadFailed = 0;
+	int32 NumSaved = 0;
+	int32 NumSaveFailed = 0;
+
+	double FindSeconds = 0.0;
+	double LoadWaitSeconds = 0.0;
+	double VisitSeconds = 0.0;
+	double SaveSeconds = 0.0;
+	double GCSeconds = 0.0;
+	double TotalSeconds = 0.0;
+};
+
+#endif
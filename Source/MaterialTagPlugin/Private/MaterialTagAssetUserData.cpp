@@ -1,9 +1,11 @@
 #include "MaterialTagAssetUserData.h"
+#include "MaterialTagPresetDatabase.h"
 #include "Engine/SkinnedAssetCommon.h"
 #include "Engine/SkeletalMesh.h"
-#include "Misc/Paths.h"
-#include "Misc/FileHelper.h"
-#include "Internationalization/Regex.h"
+#include "GameplayTagsManager.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include "Algo/Transform.h"
 #if WITH_EDITOR
 #include "Modules/ModuleManager.h"
 #include "PropertyEditorModule.h"
@@ -26,6 +28,7 @@ void UMaterialTagAssetUserData::PopulateFromMesh()
 	
 	// Clear existing entries
 	MaterialSlotTags.Empty();
+	MarkSlotTagsDirty();
 	
 	// Create an entry for each material slot using the slot name
 	for (int32 i = 0; i < Materials.Num(); i++)
@@ -34,6 +37,7 @@ void UMaterialTagAssetUserData::PopulateFromMesh()
 		Entry.MaterialSlotName = Materials[i].MaterialSlotName;
 		MaterialSlotTags.Add(Entry);
 	}
+	SlotLayoutHash = ComputeSlotLayoutHash(Materials, MaterialSlotTags);
 	
 	UE_LOG(LogTemp, Log, TEXT("MaterialTagAssetUserData: Populated %d material slot entries"), Materials.Num());
 	
@@ -45,159 +49,490 @@ void UMaterialTagAssetUserData::PopulateFromMesh()
 #endif
 }
 
-void UMaterialTagAssetUserData::EnsureAllSlotsPopulated()
+uint32 UMaterialTagAssetUserData::ComputeSlotLayoutHash(const TArray<FSkeletalMaterial>& Materials, const TArray<FMaterialSlotTagEntry>& Entries)
+{
+	// Hash the slot name strings, not the FNames: name table indices differ between sessions
+	TStringBuilder<128> SlotName;
+	auto HashName = [&SlotName](FName Name, uint32 Hash)
+	{
+		SlotName.Reset();
+		Name.AppendString(SlotName);
+		return FCrc::StrCrc32(SlotName.ToString(), Hash);
+	};
+
+	uint32 Hash = Materials.Num();
+	for (const FSkeletalMaterial& Material : Materials)
+	{
+		Hash = HashName(Material.MaterialSlotName, Hash);
+	}
+
+	// Entries replaced or reordered outside the details panel no longer match and get reconciled on load
+	Hash = HashCombine(Hash, Entries.Num());
+	for (const FMaterialSlotTagEntry& Entry : Entries)
+	{
+		Hash = HashName(Entry.MaterialSlotName, Hash);
+	}
+	return Hash;
+}
+
+bool UMaterialTagAssetUserData::EnsureAllSlotsPopulated()
 {
 	USkeletalMesh* Mesh = Cast<USkeletalMesh>(GetOuter());
-	if (!Mesh) return;
+	if (!Mesh) return false;
 
 	const TArray<FSkeletalMaterial>& Materials = Mesh->GetMaterials();
 
-	// Build set of existing slot names
-	TSet<FName> ExistingSlots;
-	for (const FMaterialSlotTagEntry& Entry : MaterialSlotTags)
+	// Same slot list and entries as the last reconcile: entries already cover it, in order
+	if (ComputeSlotLayoutHash(Materials, MaterialSlotTags) == SlotLayoutHash)
 	{
-		ExistingSlots.Add(Entry.MaterialSlotName);
+		return false;
 	}
 
-	// Add missing slots
-	bool bAdded = false;
-	for (int32 i = 0; i < Materials.Num(); i++)
+	// First entry per slot name
+	TMap<FName, int32> EntryIndex;
+	EntryIndex.Reserve(MaterialSlotTags.Num());
+	for (int32 i = 0; i < MaterialSlotTags.Num(); i++)
 	{
-		FName SlotName = Materials[i].MaterialSlotName;
-		if (!ExistingSlots.Contains(SlotName))
+		if (!EntryIndex.Contains(MaterialSlotTags[i].MaterialSlotName))
 		{
-			FMaterialSlotTagEntry Entry;
-			Entry.MaterialSlotName = SlotName;
-			MaterialSlotTags.Add(Entry);
-			bAdded = true;
+			EntryIndex.Add(MaterialSlotTags[i].MaterialSlotName, i);
 		}
 	}
 
-	if (bAdded)
+	// Walk the mesh slots in order, taking each slot's existing entry or a new empty one
+	TArray<FMaterialSlotTagEntry> Merged;
+	Merged.Reserve(FMath::Max(Materials.Num(), MaterialSlotTags.Num()));
+	TBitArray<> Taken(false, MaterialSlotTags.Num());
+	for (const FSkeletalMaterial& Material : Materials)
 	{
-		// Sort to match mesh order
-		TMap<FName, int32> SlotOrder;
-		for (int32 i = 0; i < Materials.Num(); i++)
+		int32& Index = EntryIndex.FindOrAdd(Material.MaterialSlotName, INDEX_NONE);
+		if (Index == INDEX_NONE)
 		{
-			SlotOrder.Add(Materials[i].MaterialSlotName, i);
+			Merged.AddDefaulted_GetRef().MaterialSlotName = Material.MaterialSlotName;
+			// Mark the name handled so a repeated slot name gets a single entry
+			Index = MAX_int32;
 		}
-		MaterialSlotTags.Sort([&SlotOrder](const FMaterialSlotTagEntry& A, const FMaterialSlotTagEntry& B)
+		else if (Index != MAX_int32 && !Taken[Index])
 		{
-			int32* OrderA = SlotOrder.Find(A.MaterialSlotName);
-			int32* OrderB = SlotOrder.Find(B.MaterialSlotName);
-			int32 IdxA = OrderA ? *OrderA : MAX_int32;
-			int32 IdxB = OrderB ? *OrderB : MAX_int32;
-			return IdxA < IdxB;
-		});
+			Taken[Index] = true;
+			Merged.Add(MoveTemp(MaterialSlotTags[Index]));
+		}
 	}
-}
 
-FGameplayTagContainer UMaterialTagAssetUserData::GetTagsForSlot(FName SlotName) const
-{
-	for (const FMaterialSlotTagEntry& Entry : MaterialSlotTags)
+	// Entries for slots the mesh no longer has (and duplicates) keep their relative order at the end
+	for (int32 i = 0; i < MaterialSlotTags.Num(); i++)
 	{
-		if (Entry.MaterialSlotName == SlotName)
+		if (!Taken[i])
 		{
-			return Entry.ToContainer();
+			Merged.Add(MoveTemp(MaterialSlotTags[i]));
 		}
 	}
-	return FGameplayTagContainer();
+
+	MaterialSlotTags = MoveTemp(Merged);
+	SlotLayoutHash = ComputeSlotLayoutHash(Materials, MaterialSlotTags);
+	bReconciledSinceLoad = true;
+	MarkSlotTagsDirty();
+	return true;
 }
 
-bool UMaterialTagAssetUserData::HasTagsForSlot(FName SlotName) const
+const FMaterialSlotTagEntry* UMaterialTagAssetUserData::FindSlotEntry(FName SlotName) const
 {
-	for (const FMaterialSlotTagEntry& Entry : MaterialSlotTags)
+	// Blueprints can edit MaterialSlotTags directly, so a changed entry count or a hit on a renamed entry also invalidates the index
+	for (int32 Attempt = 0; Attempt < 2; Attempt++)
 	{
-		if (Entry.MaterialSlotName == SlotName)
+		if (bSlotIndexDirty || SlotIndexEntryCount != MaterialSlotTags.Num())
+		{
+			SlotIndex.Reset();
+			SlotIndex.Reserve(MaterialSlotTags.Num());
+			for (int32 i = 0; i < MaterialSlotTags.Num(); i++)
+			{
+				// First entry for a slot wins, like the linear scan did
+				if (!SlotIndex.Contains(MaterialSlotTags[i].MaterialSlotName))
+				{
+					SlotIndex.Add(MaterialSlotTags[i].MaterialSlotName, i);
+				}
+			}
+			SlotIndexEntryCount = MaterialSlotTags.Num();
+			bSlotIndexDirty = false;
+		}
+
+		const int32* Index = SlotIndex.Find(SlotName);
+		if (!Index)
 		{
-			return Entry.Num() > 0;
+			return nullptr;
 		}
+		if (MaterialSlotTags[*Index].MaterialSlotName == SlotName)
+		{
+			return &MaterialSlotTags[*Index];
+		}
+		bSlotIndexDirty = true;
 	}
-	return false;
+	return nullptr;
 }
 
-TArray<FString> UMaterialTagAssetUserData::GetPresetMeshNames() const
+#if WITH_EDITOR
+const FName UMaterialTagAssetUserData::TaggedSlotCountRegistryTag(TEXT("MaterialTagSlotCount"));
+const FName UMaterialTagAssetUserData::MaterialTagsRegistryTag(TEXT("MaterialTags"));
+const FName UMaterialTagAssetUserData::SlotTagsRegistryTag(TEXT("MaterialTagSlotTags"));
+
+void UMaterialTagAssetUserData::GetMeshAssetRegistryTags(TArray<UObject::FAssetRegistryTag>& OutTags) const
 {
-	TArray<FString> Names;
-	Names.Add(TEXT(""));  // Empty option to clear selection
+	const USkeletalMesh* Mesh = Cast<USkeletalMesh>(GetOuter());
+	const TArray<FGameplayTagContainer> SlotTags = GetAllSlotTags();
 
-	FString IniPath = GetPresetIniPath();
-	if (!FPaths::FileExists(IniPath))
+	// Tag names cannot contain commas, tabs or newlines, so both lists split unambiguously
+	auto JoinTags = [](const FGameplayTagContainer& Tags)
 	{
-		return Names;
+		return FString::JoinBy(Tags.GetGameplayTagArray(), TEXT(","), [](const FGameplayTag& Tag) { return Tag.ToString(); });
+	};
+
+	int32 NumTaggedSlots = 0;
+	FGameplayTagContainer UsedTags;
+	FString SlotTagsValue;
+	for (int32 SlotIndex = 0; SlotIndex < SlotTags.Num(); SlotIndex++)
+	{
+		const FGameplayTagContainer& Tags = SlotTags[SlotIndex];
+		if (Tags.IsEmpty()) continue;
+
+		NumTaggedSlots++;
+		UsedTags.AppendTags(Tags);
+
+		// Without a mesh GetAllSlotTags is in entry order
+		const FName SlotName = Mesh ? Mesh->GetMaterials()[SlotIndex].MaterialSlotName : MaterialSlotTags[SlotIndex].MaterialSlotName;
+		SlotTagsValue.Appendf(TEXT("%d\t%s\t%s\n"), SlotIndex, *SlotName.ToString(), *JoinTags(Tags));
 	}
 
+	TArray<FString> TagNames;
+	TagNames.Reserve(UsedTags.Num());
+	for (const FGameplayTag& Tag : UsedTags)
+	{
+		TagNames.Add(Tag.ToString());
+	}
+	TagNames.Sort();
+
+	OutTags.Add(UObject::FAssetRegistryTag(TaggedSlotCountRegistryTag, FString::FromInt(NumTaggedSlots), UObject::FAssetRegistryTag::TT_Numerical));
+	OutTags.Add(UObject::FAssetRegistryTag(MaterialTagsRegistryTag, FString::Join(TagNames, TEXT(",")), UObject::FAssetRegistryTag::TT_Alphabetical));
+	OutTags.Add(UObject::FAssetRegistryTag(SlotTagsRegistryTag, SlotTagsValue, UObject::FAssetRegistryTag::TT_Hidden));
+}
+
+void UMaterialTagAssetUserData::ParseSlotTagsRegistryValue(const FString& Value, TArray<FMaterialTagRegistrySlot>& OutSlots)
+{
 	TArray<FString> Lines;
-	FFileHelper::LoadFileToStringArray(Lines, *IniPath);
+	Value.ParseIntoArray(Lines, TEXT("\n"));
 
+	TArray<FString> Fields;
+	TArray<FString> TagNames;
 	for (const FString& Line : Lines)
 	{
-		FString Trimmed = Line.TrimStartAndEnd();
-		if (Trimmed.StartsWith(TEXT("[")) && Trimmed.EndsWith(TEXT("]")))
+		Line.ParseIntoArray(Fields, TEXT("\t"), false);
+		if (Fields.Num() != 3) continue;
+
+		FMaterialTagRegistrySlot& Slot = OutSlots.AddDefaulted_GetRef();
+		Slot.SlotIndex = FCString::Atoi(*Fields[0]);
+		Slot.SlotName = FName(*Fields[1]);
+
+		Fields[2].ParseIntoArray(TagNames, TEXT(","));
+		for (const FString& TagName : TagNames)
 		{
-			FString SectionName = Trimmed.Mid(1, Trimmed.Len() - 2);
-			if (!SectionName.IsEmpty())
+			const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(FName(*TagName), false);
+			if (Tag.IsValid())
 			{
-				Names.Add(SectionName);
+				Slot.Tags.AddTagFast(Tag);
 			}
 		}
 	}
+}
+#endif
 
-	return Names;
+int32 UMaterialTagAssetUserData::ApplyPresetTags(const FMaterialTagPreset& Preset)
+{
+	int32 NumAdded = 0;
+	for (FMaterialSlotTagEntry& Entry : MaterialSlotTags)
+	{
+		const TArray<FGameplayTag>* PresetTags = Preset.SlotToTags.Find(Entry.MaterialSlotName);
+		if (!PresetTags) continue;
+
+		for (const FGameplayTag& Tag : *PresetTags)
+		{
+			const bool bHasTag = Entry.GameplayTags.ContainsByPredicate([&Tag](const FGameplayTagEntry& Existing)
+			{
+				return Existing.Tag == Tag;
+			});
+			if (!bHasTag)
+			{
+				Entry.GameplayTags.AddDefaulted_GetRef().Tag = Tag;
+				NumAdded++;
+			}
+		}
+	}
+
+	if (NumAdded > 0)
+	{
+		MarkSlotTagsDirty();
+	}
+	return NumAdded;
 }
 
-void UMaterialTagAssetUserData::UpdatePresetInfo()
+void UMaterialTagAssetUserData::MarkSlotTagsDirty()
 {
-	if (PresetMeshName.IsEmpty())
+	bSlotIndexDirty = true;
+	SlotBitTable.bValid = false;
+	for (const FMaterialSlotTagEntry& Entry : MaterialSlotTags)
 	{
-		PresetTags.InfoText = TEXT("");
-		return;
+		Entry.InvalidateContainer();
 	}
+}
 
-	FString IniPath = GetPresetIniPath();
-	if (!FPaths::FileExists(IniPath))
+const FGameplayTagContainer& UMaterialTagAssetUserData::GetTagsForSlot(FName SlotName) const
+{
+	const FMaterialSlotTagEntry* Entry = FindSlotEntry(SlotName);
+	return Entry ? Entry->ToContainer() : FGameplayTagContainer::EmptyContainer;
+}
+
+FGameplayTagContainer UMaterialTagAssetUserData::K2_GetTagsForSlot(FName SlotName) const
+{
+	return GetTagsForSlot(SlotName);
+}
+
+bool UMaterialTagAssetUserData::HasTagsForSlot(FName SlotName) const
+{
+	const FMaterialSlotTagEntry* Entry = FindSlotEntry(SlotName);
+	return Entry && Entry->Num() > 0;
+}
+
+TArray<FGameplayTagContainer> UMaterialTagAssetUserData::GetAllSlotTags() const
+{
+	TArray<FGameplayTagContainer> Result;
+
+	USkeletalMesh* Mesh = Cast<USkeletalMesh>(GetOuter());
+	if (!Mesh)
 	{
-		PresetTags.InfoText = TEXT("Preset INI not found.\nExpected: ") + IniPath;
-		return;
+		// No mesh to order by: fall back to entry order
+		Result.Reserve(MaterialSlotTags.Num());
+		for (const FMaterialSlotTagEntry& Entry : MaterialSlotTags)
+		{
+			Result.Add(Entry.ToContainer());
+		}
+		return Result;
 	}
 
-	TArray<FString> Lines;
-	FFileHelper::LoadFileToStringArray(Lines, *IniPath);
+	const TArray<FSkeletalMaterial>& Materials = Mesh->GetMaterials();
+	Result.SetNum(Materials.Num());
+	for (int32 i = 0; i < Materials.Num(); i++)
+	{
+		if (const FMaterialSlotTagEntry* Entry = FindSlotEntry(Materials[i].MaterialSlotName))
+		{
+			Result[i] = Entry->ToContainer();
+		}
+	}
+	return Result;
+}
 
-	// Find the section for this mesh
-	FString SectionHeader = FString::Printf(TEXT("[%s]"), *PresetMeshName);
-	bool bInSection = false;
-	FString InfoText;
+const FMaterialTagSlotBitTable& UMaterialTagAssetUserData::GetSlotBitTable() const
+{
+	UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	const uint32 NetIndexHash = TagsManager.GetNetworkGameplayTagNodeIndexHash();
 
-	for (const FString& Line : Lines)
+	// A reimport can change the mesh's slot count without touching this object
+	const USkeletalMesh* Mesh = Cast<USkeletalMesh>(GetOuter());
+	const int32 NumSlots = Mesh ? Mesh->GetMaterials().Num() : MaterialSlotTags.Num();
+
+	// Blueprints and C++ can write MaterialSlotTags without MarkSlotTagsDirty, so compare against the source like ToContainer does
+	if (SlotBitTable.bValid && SlotBitTable.NetIndexHash == NetIndexHash && SlotBitTable.NumSlots == NumSlots && SlotBitTableMatchesSlotTags())
+	{
+		return SlotBitTable;
+	}
+
+	// Explicit tags plus their implicit parents, per slot in mesh material order
+	const TArray<FGameplayTagContainer> SlotTags = GetAllSlotTags();
+	TArray<TArray<int32>> SlotBits;
+	SlotBits.SetNum(SlotTags.Num());
+	int32 MaxNetIndex = INDEX_NONE;
+
+	for (int32 Slot = 0; Slot < SlotTags.Num(); Slot++)
+	{
+		for (const FGameplayTag& Tag : SlotTags[Slot].GetGameplayTagParents())
+		{
+			const FGameplayTagNetIndex NetIndex = TagsManager.GetNetIndexFromTag(Tag);
+			if (NetIndex == INVALID_TAGNETINDEX) continue;
+
+			SlotBits[Slot].Add(NetIndex);
+			MaxNetIndex = FMath::Max(MaxNetIndex, (int32)NetIndex);
+		}
+	}
+
+	SlotBitTable.NumSlots = SlotTags.Num();
+	SlotBitTable.WordsPerSlot = (MaxNetIndex + 64) / 64;
+	SlotBitTable.Words.SetNumZeroed(SlotBitTable.NumSlots * SlotBitTable.WordsPerSlot);
+	for (int32 Slot = 0; Slot < SlotBits.Num(); Slot++)
 	{
-		FString Trimmed = Line.TrimStartAndEnd();
+		uint64* Row = SlotBitTable.Words.GetData() + Slot * SlotBitTable.WordsPerSlot;
+		for (int32 Bit : SlotBits[Slot])
+		{
+			Row[Bit >> 6] |= 1ull << (Bit & 63);
+		}
+	}
 
-		if (Trimmed.StartsWith(TEXT("[")))
+	SlotBitTable.SourceSlotNames.Reset(MaterialSlotTags.Num());
+	SlotBitTable.SourceTagCounts.Reset(MaterialSlotTags.Num());
+	SlotBitTable.SourceTags.Reset();
+	for (const FMaterialSlotTagEntry& Entry : MaterialSlotTags)
+	{
+		SlotBitTable.SourceSlotNames.Add(Entry.MaterialSlotName);
+		SlotBitTable.SourceTagCounts.Add(Entry.GameplayTags.Num());
+		for (const FGameplayTagEntry& TagEntry : Entry.GameplayTags)
 		{
-			if (bInSection)
+			SlotBitTable.SourceTags.Add(TagEntry.Tag);
+		}
+	}
+
+	SlotBitTable.NetIndexHash = NetIndexHash;
+	SlotBitTable.bValid = true;
+	return SlotBitTable;
+}
+
+bool UMaterialTagAssetUserData::SlotBitTableMatchesSlotTags() const
+{
+	if (SlotBitTable.SourceSlotNames.Num() != MaterialSlotTags.Num())
+	{
+		return false;
+	}
+
+	int32 TagIndex = 0;
+	for (int32 i = 0; i < MaterialSlotTags.Num(); i++)
+	{
+		const FMaterialSlotTagEntry& Entry = MaterialSlotTags[i];
+		if (SlotBitTable.SourceSlotNames[i] != Entry.MaterialSlotName || SlotBitTable.SourceTagCounts[i] != Entry.GameplayTags.Num())
+		{
+			return false;
+		}
+
+		for (const FGameplayTagEntry& TagEntry : Entry.GameplayTags)
+		{
+			if (SlotBitTable.SourceTags[TagIndex++] != TagEntry.Tag)
 			{
-				break;  // Hit next section, done
+				return false;
 			}
-			if (Trimmed.Equals(SectionHeader, ESearchCase::IgnoreCase))
+		}
+	}
+	return true;
+}
+
+TBitArray<> UMaterialTagAssetUserData::SlotsMatchingTag(const FGameplayTag& Tag) const
+{
+	const FMaterialTagSlotBitTable& Table = GetSlotBitTable();
+	TBitArray<> Result(false, Table.NumSlots);
+
+	const FGameplayTagNetIndex NetIndex = Tag.IsValid() ? UGameplayTagsManager::Get().GetNetIndexFromTag(Tag) : INVALID_TAGNETINDEX;
+	if (NetIndex == INVALID_TAGNETINDEX || NetIndex >= Table.WordsPerSlot * 64)
+	{
+		return Result;
+	}
+
+	const int32 Word = NetIndex >> 6;
+	const uint64 Mask = 1ull << (NetIndex & 63);
+	for (int32 Slot = 0; Slot < Table.NumSlots; Slot++)
+	{
+		if (Table.GetRow(Slot)[Word] & Mask)
+		{
+			Result[Slot] = true;
+		}
+	}
+	return Result;
+}
+
+TBitArray<> UMaterialTagAssetUserData::SlotsMatchingAnyTag(const FGameplayTagContainer& Tags) const
+{
+	const FMaterialTagSlotBitTable& Table = GetSlotBitTable();
+	TBitArray<> Result(false, Table.NumSlots);
+	if (Table.WordsPerSlot == 0)
+	{
+		return Result;
+	}
+
+	// Query row over the same net-index space; tags outside every slot row can't match anything
+	UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	TArray<uint64, TInlineAllocator<8>> Query;
+	Query.SetNumZeroed(Table.WordsPerSlot);
+	for (const FGameplayTag& Tag : Tags)
+	{
+		const FGameplayTagNetIndex NetIndex = TagsManager.GetNetIndexFromTag(Tag);
+		if (NetIndex != INVALID_TAGNETINDEX && NetIndex < Table.WordsPerSlot * 64)
+		{
+			Query[NetIndex >> 6] |= 1ull << (NetIndex & 63);
+		}
+	}
+
+	for (int32 Slot = 0; Slot < Table.NumSlots; Slot++)
+	{
+		const uint64* Row = Table.GetRow(Slot);
+		for (int32 Word = 0; Word < Table.WordsPerSlot; Word++)
+		{
+			if (Row[Word] & Query[Word])
 			{
-				bInSection = true;
+				Result[Slot] = true;
+				break;
 			}
-			continue;
 		}
+	}
+	return Result;
+}
+
+TArray<FString> UMaterialTagAssetUserData::GetPresetMeshNames() const
+{
+	TArray<FString> Names;
+	Names.Add(TEXT(""));  // Empty option to clear selection
+
+	// GetOptions runs on the UI thread: never wait for disk. Until the names are loaded, offer the current selection only.
+	TArray<FString> PresetNames;
+	if (FMaterialTagPresetDatabase::Get().TryGetPresetNames(PresetNames))
+	{
+		Names.Append(MoveTemp(PresetNames));
+	}
+	else if (!PresetMeshName.IsEmpty())
+	{
+		Names.Add(PresetMeshName);
+	}
+	return Names;
+}
+
+void UMaterialTagAssetUserData::UpdatePresetInfo()
+{
+	if (PresetMeshName.IsEmpty())
+	{
+		PresetTags.InfoText = TEXT("");
+		return;
+	}
 
-		if (!bInSection) continue;
-		if (Trimmed.IsEmpty() || Trimmed.StartsWith(TEXT(";"))) continue;
+	// The preset display customization calls back in here once a pending lookup completes
+	TSharedPtr<const FMaterialTagPreset> Preset;
+	const EMaterialTagPresetLookup Lookup = FMaterialTagPresetDatabase::Get().TryFindPreset(PresetMeshName, Preset);
+	if (Lookup == EMaterialTagPresetLookup::Pending)
+	{
+		PresetTags.InfoText = FString::Printf(TEXT("Loading preset '%s'..."), *PresetMeshName);
+		return;
+	}
+	if (Lookup == EMaterialTagPresetLookup::NoPresetFile)
+	{
+		PresetTags.InfoText = TEXT("Preset INI not found.\nExpected: ") + FMaterialTagPresetDatabase::GetPresetIniPath()
+			+ TEXT("\nor shard folder: ") + FMaterialTagPresetDatabase::GetPresetShardDirectory();
+		return;
+	}
 
-		// Parse Tag=Slot1, Slot2
-		FString TagName, SlotList;
-		if (Trimmed.Split(TEXT("="), &TagName, &SlotList))
+	FString InfoText;
+	if (Preset.IsValid())
+	{
+		for (const FMaterialTagPresetTag& Entry : Preset->Tags)
 		{
 			if (!InfoText.IsEmpty())
 			{
 				InfoText += TEXT("\n");
 			}
-			InfoText += FString::Printf(TEXT("%s\n    Slots: %s"), *TagName.TrimStartAndEnd(), *SlotList.TrimStartAndEnd());
+
+			TArray<FString> SlotNames;
+			Algo::Transform(Entry.Slots, SlotNames, [](FName Slot) { return Slot.ToString(); });
+			InfoText += FString::Printf(TEXT("%s%s\n    Slots: %s"), *Entry.TagName.ToString(),
+				Entry.Tag.IsValid() ? TEXT("") : TEXT(" (unknown tag)"), *FString::Join(SlotNames, TEXT(", ")));
 		}
 	}
 
@@ -216,64 +551,123 @@ void UMaterialTagAssetUserData::AutoMatchPresetFromMesh()
 	USkeletalMesh* Mesh = Cast<USkeletalMesh>(GetOuter());
 	if (!Mesh) return;
 
-	FString MeshName = Mesh->GetName();
-	TArray<FString> Presets = GetPresetMeshNames();
+	const FString MeshName = Mesh->GetName();
 
-	// Try exact match first
-	for (const FString& P : Presets)
+	TArray<FMaterialTagPresetCandidate> Candidates;
+	if (FMaterialTagPresetDatabase::Get().TryRankPresets(MeshName, 1, Candidates) != EMaterialTagPresetLookup::Pending)
 	{
-		if (P.Equals(MeshName, ESearchCase::IgnoreCase))
-		{
-			PresetMeshName = P;
-			return;
-		}
+		ApplyAutoMatch(MeshName, Candidates);
+		return;
 	}
 
-	// Try substring match (mesh name contains preset name or vice versa)
-	for (const FString& P : Presets)
+	// Names or the match index are still loading: rank on a worker instead of blocking the editor
+	TWeakObjectPtr<UMaterialTagAssetUserData> WeakThis(this);
+	FMaterialTagPresetDatabase::Get().RankPresetsAsync(MeshName, 1).Next([WeakThis, MeshName](TArray<FMaterialTagPresetCandidate> Result)
 	{
-		if (P.IsEmpty()) continue;
-		if (MeshName.Contains(P) || P.Contains(MeshName))
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, MeshName, Result = MoveTemp(Result)]()
 		{
-			PresetMeshName = P;
-			return;
-		}
-	}
+			UMaterialTagAssetUserData* This = WeakThis.Get();
+			if (!This || !This->bAutoMatchPreset || !This->ApplyAutoMatch(MeshName, Result)) return;
 
-	// Try matching by character ID (e.g. "1014001" in both names)
-	// Extract digits from mesh name
-	FRegexPattern Pattern(TEXT("(\\d{7})"));
-	FRegexMatcher Matcher(Pattern, MeshName);
-	if (Matcher.FindNext())
+			This->UpdatePresetInfo();
+#if WITH_EDITOR
+			FPropertyEditorModule& PropertyModule = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
+			PropertyModule.NotifyCustomizationModuleChanged();
+#endif
+		});
+	});
+}
+
+bool UMaterialTagAssetUserData::ApplyAutoMatch(const FString& MeshName, const TArray<FMaterialTagPresetCandidate>& Candidates)
+{
+	if (Candidates.Num() == 0 || Candidates[0].Score < FMaterialTagPresetDatabase::AutoMatchConfidence)
 	{
-		FString CharId = Matcher.GetCaptureGroup(1);
-		for (const FString& P : Presets)
-		{
-			if (P.Contains(CharId))
-			{
-				PresetMeshName = P;
-				return;
-			}
-		}
+		UE_LOG(LogTemp, Log, TEXT("MaterialTagAssetUserData: No preset matches '%s' with enough confidence (best: '%s', %.2f)"),
+			*MeshName, Candidates.Num() > 0 ? *Candidates[0].Name : TEXT(""), Candidates.Num() > 0 ? Candidates[0].Score : 0.0f);
+		return false;
 	}
+
+	PresetMeshName = Candidates[0].Name;
+	return true;
 }
 
-FString UMaterialTagAssetUserData::GetPresetIniPath()
+#if WITH_EDITOR
+namespace
 {
-	return FPaths::ProjectPluginsDir() / TEXT("MaterialTagPlugin") / TEXT("Config") / TEXT("MaterialTagPresets.ini");
+	/** User data loaded before their mesh finished loading; reconciled once the load completes */
+	TArray<TWeakObjectPtr<UMaterialTagAssetUserData>> DeferredSlotReconciles;
+	FCriticalSection DeferredSlotReconcilesLock;
+
+	bool IsOuterStillLoading(const UObject* UserData)
+	{
+		const UObject* Outer = UserData->GetOuter();
+		return Outer && Outer->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad);
+	}
 }
 
-#if WITH_EDITOR
 void UMaterialTagAssetUserData::PostLoad()
 {
 	Super::PostLoad();
-	EnsureAllSlotsPopulated();
+
+	// May run on the async loading thread: only this object's own state is touched here
+	MarkSlotTagsDirty();
+
+	// Reconciling reads the mesh's material list, so it needs the game thread and a fully loaded mesh
+	if (IsInGameThread() && !IsOuterStillLoading(this))
+	{
+		EnsureAllSlotsPopulated();
+		return;
+	}
+
+	FScopeLock Lock(&DeferredSlotReconcilesLock);
+	DeferredSlotReconciles.Add(this);
+}
+
+void UMaterialTagAssetUserData::FlushDeferredSlotReconciles()
+{
+	check(IsInGameThread());
+
+	TArray<TWeakObjectPtr<UMaterialTagAssetUserData>> Pending;
+	{
+		FScopeLock Lock(&DeferredSlotReconcilesLock);
+		Pending = MoveTemp(DeferredSlotReconciles);
+	}
+
+	TArray<TWeakObjectPtr<UMaterialTagAssetUserData>> StillLoading;
+	for (const TWeakObjectPtr<UMaterialTagAssetUserData>& WeakUserData : Pending)
+	{
+		UMaterialTagAssetUserData* UserData = WeakUserData.Get();
+		if (!UserData) continue;
+
+		if (IsOuterStillLoading(UserData))
+		{
+			StillLoading.Add(WeakUserData);
+			continue;
+		}
+		UserData->EnsureAllSlotsPopulated();
+	}
+
+	if (StillLoading.Num() > 0)
+	{
+		FScopeLock Lock(&DeferredSlotReconcilesLock);
+		DeferredSlotReconciles.Append(StillLoading);
+	}
+}
+
+void UMaterialTagAssetUserData::PostEditUndo()
+{
+	Super::PostEditUndo();
+	MarkSlotTagsDirty();
 }
 
 void UMaterialTagAssetUserData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 
+	// Slot entries may have been added, removed, reordered or renamed, or had their tags edited.
+	// SlotLayoutHash covers the entry names, so hand-edited entries are reconciled again on next load.
+	MarkSlotTagsDirty();
+
 	FName PropName = PropertyChangedEvent.GetPropertyName();
 
 	bool bNeedsRefresh = false;
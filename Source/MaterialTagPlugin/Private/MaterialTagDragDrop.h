@@ -25,20 +25,20 @@ inline const FSlateBrush* GetPillBrush()
 }
 
 /**
- * Drag-drop operation that carries a GameplayTag name.
+ * Drag-drop operation that carries a resolved GameplayTag.
  */
 class FMaterialTagDragDropOp : public FDragDropOperation
 {
 public:
 	DRAG_DROP_OPERATOR_TYPE(FMaterialTagDragDropOp, FDragDropOperation)
 
-	FString TagName;
+	FGameplayTag Tag;
 	FString SlotHint;
 
-	static TSharedRef<FMaterialTagDragDropOp> New(const FString& InTagName, const FString& InSlotHint)
+	static TSharedRef<FMaterialTagDragDropOp> New(const FGameplayTag& InTag, const FString& InSlotHint)
 	{
 		TSharedRef<FMaterialTagDragDropOp> Op = MakeShareable(new FMaterialTagDragDropOp());
-		Op->TagName = InTagName;
+		Op->Tag = InTag;
 		Op->SlotHint = InSlotHint;
 		Op->Construct();
 		return Op;
@@ -52,7 +52,7 @@ public:
 			.Padding(FMargin(10, 4))
 			[
 				SNew(STextBlock)
-				.Text(FText::FromString(TagName))
+				.Text(FText::FromName(Tag.GetTagName()))
 				.ColorAndOpacity(FLinearColor::White)
 			];
 	}
@@ -60,43 +60,54 @@ public:
 
 /**
  * A draggable tag pill widget (pill-shaped, UE-native style).
+ * Pills for tags that didn't resolve at load are greyed out and can't be dragged.
  */
 class STagPill : public SCompoundWidget
 {
 public:
 	SLATE_BEGIN_ARGS(STagPill)
 		: _TagName()
+		, _Tag()
 		, _SlotHint()
 	{}
-		SLATE_ARGUMENT(FString, TagName)
+		SLATE_ARGUMENT(FName, TagName)
+		SLATE_ARGUMENT(FGameplayTag, Tag)
 		SLATE_ARGUMENT(FString, SlotHint)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs)
 	{
-		TagName = InArgs._TagName;
+		Tag = InArgs._Tag;
 		SlotHint = InArgs._SlotHint;
 
+		const bool bValid = Tag.IsValid();
+		const FText ToolTip = bValid
+			? FText::FromString(FString::Printf(TEXT("Slots: %s\nDrag onto a material slot entry"), *SlotHint))
+			: FText::FromString(FString::Printf(TEXT("Slots: %s\nNot a registered gameplay tag"), *SlotHint));
+
 		ChildSlot
 		[
 			SNew(SBorder)
 			.BorderImage(GetPillBrush())
-			.BorderBackgroundColor(FLinearColor(0.22f, 0.22f, 0.25f, 1.0f))
+			.BorderBackgroundColor(bValid ? FLinearColor(0.22f, 0.22f, 0.25f, 1.0f) : FLinearColor(0.35f, 0.15f, 0.15f, 1.0f))
 			.Padding(FMargin(10, 4))
-			.ToolTipText(FText::FromString(FString::Printf(TEXT("Slots: %s\nDrag onto a material slot entry"), *SlotHint)))
+			.ToolTipText(ToolTip)
 			[
 				SNew(STextBlock)
-				.Text(FText::FromString(TagName))
-				.ColorAndOpacity(FLinearColor(0.85f, 0.85f, 0.85f))
+				.Text(FText::FromName(InArgs._TagName))
+				.ColorAndOpacity(bValid ? FLinearColor(0.85f, 0.85f, 0.85f) : FLinearColor(0.6f, 0.45f, 0.45f))
 			]
 		];
 
-		SetCursor(EMouseCursor::GrabHand);
+		if (bValid)
+		{
+			SetCursor(EMouseCursor::GrabHand);
+		}
 	}
 
 	virtual FReply OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override
 	{
-		if (MouseEvent.GetEffectingButton() == EKeys::LeftMouseButton)
+		if (Tag.IsValid() && MouseEvent.GetEffectingButton() == EKeys::LeftMouseButton)
 		{
 			return FReply::Handled().DetectDrag(SharedThis(this), EKeys::LeftMouseButton);
 		}
@@ -105,11 +116,11 @@ public:
 
 	virtual FReply OnDragDetected(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override
 	{
-		return FReply::Handled().BeginDragDrop(FMaterialTagDragDropOp::New(TagName, SlotHint));
+		return FReply::Handled().BeginDragDrop(FMaterialTagDragDropOp::New(Tag, SlotHint));
 	}
 
 private:
-	FString TagName;
+	FGameplayTag Tag;
 	FString SlotHint;
 };
 
@@ -119,12 +130,12 @@ private:
 class SRemovableTagPill : public SCompoundWidget
 {
 public:
-	DECLARE_DELEGATE_OneParam(FOnRemoveTag, const FString& /*TagName*/);
+	DECLARE_DELEGATE_OneParam(FOnRemoveTag, FName /*TagName*/);
 
 	SLATE_BEGIN_ARGS(SRemovableTagPill)
 		: _TagName()
 	{}
-		SLATE_ARGUMENT(FString, TagName)
+		SLATE_ARGUMENT(FName, TagName)
 		SLATE_EVENT(FOnRemoveTag, OnRemove)
 	SLATE_END_ARGS()
 
@@ -147,7 +158,7 @@ public:
 				.Padding(0, 0, 4, 0)
 				[
 					SNew(STextBlock)
-					.Text(FText::FromString(StoredTagName))
+					.Text(FText::FromName(StoredTagName))
 					.ColorAndOpacity(FLinearColor(0.85f, 0.85f, 0.85f))
 				]
 				+ SHorizontalBox::Slot()
@@ -176,7 +187,7 @@ private:
 		return FReply::Handled();
 	}
 
-	FString StoredTagName;
+	FName StoredTagName;
 	FOnRemoveTag OnRemove;
 };
 
@@ -186,7 +197,7 @@ private:
 class STagDropTarget : public SCompoundWidget
 {
 public:
-	DECLARE_DELEGATE_OneParam(FOnTagDropped, const FString& /*TagName*/);
+	DECLARE_DELEGATE_OneParam(FOnTagDropped, const FGameplayTag& /*Tag*/);
 
 	SLATE_BEGIN_ARGS(STagDropTarget) {}
 		SLATE_DEFAULT_SLOT(FArguments, Content)
@@ -226,9 +237,9 @@ public:
 	virtual FReply OnDrop(const FGeometry& MyGeometry, const FDragDropEvent& DragDropEvent) override
 	{
 		TSharedPtr<FMaterialTagDragDropOp> TagOp = DragDropEvent.GetOperationAs<FMaterialTagDragDropOp>();
-		if (TagOp.IsValid() && !TagOp->TagName.IsEmpty())
+		if (TagOp.IsValid() && TagOp->Tag.IsValid())
 		{
-			OnTagDropped.ExecuteIfBound(TagOp->TagName);
+			OnTagDropped.ExecuteIfBound(TagOp->Tag);
 			return FReply::Handled();
 		}
 		return FReply::Unhandled();
@@ -0,0 +1,217 @@
+#include "MaterialTagExportCommandlet.h"
+
+#if WITH_EDITOR
+#include "MaterialTagAssetUserData.h"
+#include "MaterialTagManifest.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/ARFilter.h"
+#include "Engine/SkeletalMesh.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Algo/Unique.h"
+
+namespace
+{
+	/** Share of the previous manifest's string table that may go unused before an incremental export is turned into a full one */
+	constexpr float MaxUnreferencedStringFraction = 0.25f;
+}
+#endif
+
+UMaterialTagExportCommandlet::UMaterialTagExportCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Write the slot tags of every tagged skeletal mesh to a single manifest file, from the asset registry");
+	HelpUsage = TEXT("-run=MaterialTagExport [-Output=<file>] [-Path=/Game/...] [-Full]");
+}
+
+int32 UMaterialTagExportCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("MaterialTagPlugin") / TEXT("MaterialTagManifest.bin");
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	OutputPath = FPaths::ConvertRelativePathToFull(OutputPath);
+
+	FString ContentPath;
+	FParse::Value(*Params, TEXT("Path="), ContentPath);
+
+	const bool bFull = FParse::Param(*Params, TEXT("Full"));
+
+	// Commandlets start with an empty registry
+	const double ScanStartTime = FPlatformTime::Seconds();
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	if (ContentPath.IsEmpty())
+	{
+		AssetRegistry.SearchAllAssets(true);
+	}
+	else
+	{
+		AssetRegistry.ScanPathsSynchronous({ ContentPath });
+	}
+	const double ScanSeconds = FPlatformTime::Seconds() - ScanStartTime;
+
+	// Only package names are kept across the whole project; records are produced one package at a time
+	const double FindStartTime = FPlatformTime::Seconds();
+	FARFilter Filter;
+	Filter.ClassPaths.Add(USkeletalMesh::StaticClass()->GetClassPathName());
+	Filter.TagsAndValues.Add(UMaterialTagAssetUserData::SlotTagsRegistryTag);
+	if (!ContentPath.IsEmpty())
+	{
+		Filter.PackagePaths.Add(FName(*ContentPath));
+		Filter.bRecursivePaths = true;
+	}
+
+	TArray<FName> PackageNames;
+	AssetRegistry.EnumerateAssets(Filter, [&PackageNames](const FAssetData& AssetData)
+	{
+		PackageNames.Add(AssetData.PackageName);
+		return true;
+	});
+	PackageNames.Sort(FNameLexicalLess());
+	PackageNames.SetNum(Algo::Unique(PackageNames));
+	const double FindSeconds = FPlatformTime::Seconds() - FindStartTime;
+
+	const double WriteStartTime = FPlatformTime::Seconds();
+
+	// The previous manifest's records can be copied forward if the cache was written alongside it
+	const FString CachePath = FMaterialTagManifestCache::GetCachePath(OutputPath);
+	FMaterialTagManifestCache OldCache;
+	FMaterialTagManifestReader OldManifest;
+	bool bIncremental = false;
+	if (!bFull && OldCache.Load(CachePath) && OldManifest.Open(OutputPath))
+	{
+		bIncremental = OldManifest.GetFileSize() == OldCache.ManifestSize;
+		if (!bIncremental)
+		{
+			UE_LOG(LogTemp, Display, TEXT("MaterialTagExportCommandlet: Cache does not match %s, exporting everything"), *OutputPath);
+			OldManifest.Close();
+		}
+		// The seeded string table never sheds names that records stopped using; rebuild it once too many pile up
+		else if (OldCache.NumUnreferencedStrings > OldManifest.GetStrings().Num() * MaxUnreferencedStringFraction)
+		{
+			UE_LOG(LogTemp, Display, TEXT("MaterialTagExportCommandlet: %d of %d strings in %s are unused, exporting everything"),
+				OldCache.NumUnreferencedStrings, OldManifest.GetStrings().Num(), *OutputPath);
+			bIncremental = false;
+			OldManifest.Close();
+		}
+	}
+
+	// Seeding with the old string table keeps the ids inside copied records valid
+	FMaterialTagManifestWriter Writer;
+	if (!Writer.Open(OutputPath, bIncremental ? TConstArrayView<FName>(OldManifest.GetStrings()) : TConstArrayView<FName>()))
+	{
+		return 1;
+	}
+
+	FMaterialTagManifestCache NewCache;
+	NewCache.Entries.Reserve(PackageNames.Num());
+	int32 NumCopied = 0;
+	int32 NumEncoded = 0;
+
+	TArray<FAssetData> PackageAssets;
+	TArray<FString> Values;
+	TArray<FMaterialTagRegistrySlot> Slots;
+	TArray<uint8> RecordBytes;
+	for (const FName& PackageName : PackageNames)
+	{
+		FMaterialTagManifestCache::FEntry Entry;
+		Entry.RecordOffset = Writer.GetOffset();
+		const int32 NumMeshesBefore = Writer.GetNumMeshes();
+
+		if (const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName))
+		{
+			Entry.PackageSavedHash = PackageData->GetPackageSavedHash();
+		}
+
+		// Unchanged package: its records are reused without touching its tag values
+		const FMaterialTagManifestCache::FEntry* Cached = bIncremental ? OldCache.Entries.Find(PackageName) : nullptr;
+		bool bReuse = Cached && !Entry.PackageSavedHash.IsZero() && Entry.PackageSavedHash == Cached->PackageSavedHash;
+
+		Values.Reset();
+		bool bHaveValues = false;
+		auto GatherValues = [&]()
+		{
+			PackageAssets.Reset();
+			AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssets);
+			FString Value;
+			for (const FAssetData& AssetData : PackageAssets)
+			{
+				if (AssetData.GetTagValue(UMaterialTagAssetUserData::SlotTagsRegistryTag, Value))
+				{
+					Entry.SlotTagsHash = FCrc::StrCrc32(*Value, Entry.SlotTagsHash);
+					Values.Add(MoveTemp(Value));
+				}
+			}
+			bHaveValues = true;
+		};
+
+		if (bReuse)
+		{
+			Entry.SlotTagsHash = Cached->SlotTagsHash;
+		}
+		else
+		{
+			// Saved again or new: a save that didn't touch the slot tags still reuses the records
+			GatherValues();
+			bReuse = Cached && Entry.SlotTagsHash == Cached->SlotTagsHash;
+		}
+
+		if (bReuse && OldManifest.ReadRecords(Cached->RecordOffset, Cached->RecordSize, RecordBytes))
+		{
+			Writer.AddRawRecords(RecordBytes, Cached->NumRecords);
+			NumCopied++;
+		}
+		else
+		{
+			if (!bHaveValues)
+			{
+				Entry.SlotTagsHash = 0;
+				GatherValues();
+			}
+			for (const FString& Value : Values)
+			{
+				Slots.Reset();
+				UMaterialTagAssetUserData::ParseSlotTagsRegistryValue(Value, Slots);
+				if (Slots.Num() > 0)
+				{
+					Writer.AddMesh(PackageName, Slots);
+				}
+			}
+			NumEncoded++;
+		}
+
+		Entry.RecordSize = Writer.GetOffset() - Entry.RecordOffset;
+		Entry.NumRecords = Writer.GetNumMeshes() - NumMeshesBefore;
+		NewCache.Entries.Add(PackageName, Entry);
+	}
+
+	// Release the old manifest before the new one replaces it
+	OldManifest.Close();
+	const bool bSuccess = Writer.Close();
+	if (bSuccess)
+	{
+		NewCache.ManifestSize = IFileManager::Get().FileSize(*OutputPath);
+		NewCache.NumUnreferencedStrings = Writer.GetNumUnreferencedStrings();
+		if (!NewCache.Save(CachePath))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("MaterialTagExportCommandlet: Could not write %s; the next export will be a full one"), *CachePath);
+		}
+	}
+	const double WriteSeconds = FPlatformTime::Seconds() - WriteStartTime;
+
+	UE_LOG(LogTemp, Display, TEXT("MaterialTagExportCommandlet: %d mesh(es), %d distinct string(s) (%d unused) written to %s"),
+		Writer.GetNumMeshes(), Writer.GetNumStrings(), Writer.GetNumUnreferencedStrings(), *OutputPath);
+	UE_LOG(LogTemp, Display, TEXT("MaterialTagExportCommandlet: %d package(s) copied forward, %d re-encoded%s"),
+		NumCopied, NumEncoded, bIncremental ? TEXT("") : TEXT(" (full export)"));
+	UE_LOG(LogTemp, Display, TEXT("MaterialTagExportCommandlet: registry scan %.2fs, find %.2fs, write %.2fs"),
+		ScanSeconds, FindSeconds, WriteSeconds);
+
+	return bSuccess ? 0 : 1;
+#else
+	return 1;
+#endif
+}
@@ -0,0 +1,227 @@
+#include "MaterialTagGeneratePresetsCommandlet.h"
+
+#if WITH_EDITOR
+#include "MaterialTagAssetPipeline.h"
+#include "MaterialTagAssetUserData.h"
+#include "MaterialTagPresetDatabase.h"
+#include "Engine/SkeletalMesh.h"
+#include "Async/Async.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+	/** What a preset section needs from a mesh, copied on the game thread so it can be formatted on a worker */
+	struct FMeshSnapshot
+	{
+		FString MeshPath;
+		FString MeshName;
+		TArray<FName> MeshSlots;
+
+		struct FEntry
+		{
+			FName SlotName;
+			TArray<FName> TagNames;
+		};
+		TArray<FEntry> Entries;
+	};
+
+	struct FPresetSection
+	{
+		FString Name;
+		FString FoldedName;
+		FString MeshPath;
+
+		/** Section text, header included; empty if the mesh has no tags */
+		FString Text;
+		int32 NumTags = 0;
+	};
+
+	FMeshSnapshot TakeSnapshot(const USkeletalMesh& Mesh, const UMaterialTagAssetUserData& UserData)
+	{
+		FMeshSnapshot Snapshot;
+		Snapshot.MeshPath = Mesh.GetPathName();
+		Snapshot.MeshName = Mesh.GetName();
+
+		for (const FSkeletalMaterial& Material : Mesh.GetMaterials())
+		{
+			Snapshot.MeshSlots.Add(Material.MaterialSlotName);
+		}
+
+		Snapshot.Entries.Reserve(UserData.MaterialSlotTags.Num());
+		for (const FMaterialSlotTagEntry& Entry : UserData.MaterialSlotTags)
+		{
+			FMeshSnapshot::FEntry& SnapshotEntry = Snapshot.Entries.AddDefaulted_GetRef();
+			SnapshotEntry.SlotName = Entry.MaterialSlotName;
+			for (const FGameplayTagEntry& TagEntry : Entry.GameplayTags)
+			{
+				SnapshotEntry.TagNames.Add(TagEntry.Tag.GetTagName());
+			}
+		}
+		return Snapshot;
+	}
+
+	/** Format one mesh as a preset section. Runs on the thread pool: touches only the snapshot. */
+	FPresetSection FormatSection(const FMeshSnapshot& Snapshot)
+	{
+		FPresetSection Section;
+		Section.Name = Snapshot.MeshName;
+		Section.FoldedName = FMaterialTagPresetDatabase::FoldSectionName(Snapshot.MeshName);
+		Section.MeshPath = Snapshot.MeshPath;
+
+		// First entry per slot, as the runtime lookups use; entries for slots the mesh no longer has are dropped
+		TMap<FName, const FMeshSnapshot::FEntry*> EntryBySlot;
+		for (const FMeshSnapshot::FEntry& Entry : Snapshot.Entries)
+		{
+			if (!EntryBySlot.Contains(Entry.SlotName) && Snapshot.MeshSlots.Contains(Entry.SlotName))
+			{
+				EntryBySlot.Add(Entry.SlotName, &Entry);
+			}
+		}
+
+		// Tag -> slots in slot index order
+		TMap<FName, TArray<FName>> SlotsByTag;
+		for (const FName& SlotName : Snapshot.MeshSlots)
+		{
+			const FMeshSnapshot::FEntry* const* Entry = EntryBySlot.Find(SlotName);
+			if (!Entry) continue;
+
+			for (const FName& TagName : (*Entry)->TagNames)
+			{
+				if (!TagName.IsNone())
+				{
+					SlotsByTag.FindOrAdd(TagName).AddUnique(SlotName);
+				}
+			}
+
+			// A slot name repeated on the mesh only contributes once
+			EntryBySlot.Remove(SlotName);
+		}
+
+		if (SlotsByTag.Num() == 0)
+		{
+			return Section;
+		}
+		SlotsByTag.KeySort(FNameLexicalLess());
+		Section.NumTags = SlotsByTag.Num();
+
+		Section.Text.Appendf(TEXT("[%s]\n"), *Snapshot.MeshName);
+		FMaterialTagPresetDatabase::AppendSectionBody(Section.Text, Snapshot.MeshSlots, SlotsByTag.Array());
+		return Section;
+	}
+}
+#endif
+
+UMaterialTagGeneratePresetsCommandlet::UMaterialTagGeneratePresetsCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Write a preset INI with one section per tagged skeletal mesh under a content path");
+	HelpUsage = TEXT("-run=MaterialTagGeneratePresets -Path=/Game/Characters [-Output=<file>] [-MaxInFlight=32] [-BatchSize=64]");
+}
+
+int32 UMaterialTagGeneratePresetsCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString ContentPath;
+	if (!FParse::Value(*Params, TEXT("Path="), ContentPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("MaterialTagGeneratePresetsCommandlet: Missing -Path. Usage: %s"), *HelpUsage);
+		return 1;
+	}
+
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("MaterialTagPlugin") / TEXT("MaterialTagPresets.ini");
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	OutputPath = FPaths::ConvertRelativePathToFull(OutputPath);
+
+	int32 MaxInFlight = 32;
+	FParse::Value(*Params, TEXT("MaxInFlight="), MaxInFlight);
+	int32 BatchSize = 64;
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+
+	// Read-only pass: nothing is saved
+	FMaterialTagAssetPipeline Pipeline(MaxInFlight, BatchSize, false);
+	const TArray<FName> PackageNames = Pipeline.FindPackages(ContentPath, USkeletalMesh::StaticClass());
+
+	TArray<TFuture<FPresetSection>> Pending;
+	const bool bLoadedAll = Pipeline.Run(PackageNames, [&Pending](UPackage& Package)
+	{
+		TArray<UObject*> Objects;
+		GetObjectsWithPackage(&Package, Objects, false);
+		for (UObject* Object : Objects)
+		{
+			USkeletalMesh* Mesh = Cast<USkeletalMesh>(Object);
+			const UMaterialTagAssetUserData* UserData = Mesh ? Mesh->GetAssetUserData<UMaterialTagAssetUserData>() : nullptr;
+			if (!UserData) continue;
+
+			Pending.Add(Async(EAsyncExecution::ThreadPool, [Snapshot = TakeSnapshot(*Mesh, *UserData)]()
+			{
+				return FormatSection(Snapshot);
+			}));
+		}
+		return false;
+	});
+
+	const double WaitStartTime = FPlatformTime::Seconds();
+	TArray<FPresetSection> Sections;
+	Sections.Reserve(Pending.Num());
+	int32 NumUntagged = 0;
+	for (TFuture<FPresetSection>& Future : Pending)
+	{
+		FPresetSection Section = Future.Get();
+		if (Section.Text.IsEmpty())
+		{
+			NumUntagged++;
+			continue;
+		}
+		Sections.Add(MoveTemp(Section));
+	}
+	const double WaitSeconds = FPlatformTime::Seconds() - WaitStartTime;
+
+	// Completion order depends on the loader; sort by section name, then path so the kept duplicate is stable
+	Sections.Sort([](const FPresetSection& A, const FPresetSection& B)
+	{
+		const int32 Compare = A.FoldedName.Compare(B.FoldedName, ESearchCase::CaseSensitive);
+		return Compare != 0 ? Compare < 0 : A.MeshPath < B.MeshPath;
+	});
+
+	FString Output;
+	Output.Appendf(TEXT("; Generated by -run=MaterialTagGeneratePresets -Path=%s\n"), *ContentPath);
+	int32 NumWritten = 0;
+	int32 NumTags = 0;
+	for (int32 Index = 0; Index < Sections.Num(); Index++)
+	{
+		const FPresetSection& Section = Sections[Index];
+		if (Index > 0 && Section.FoldedName == Sections[Index - 1].FoldedName)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("MaterialTagGeneratePresetsCommandlet: %s has the same name as %s; only the first is written"),
+				*Section.MeshPath, *Sections[Index - 1].MeshPath);
+			continue;
+		}
+
+		Output += TEXT('\n');
+		Output += Section.Text;
+		NumWritten++;
+		NumTags += Section.NumTags;
+	}
+
+	const bool bWritten = FFileHelper::SaveStringToFile(Output, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	if (!bWritten)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MaterialTagGeneratePresetsCommandlet: Could not write %s"), *OutputPath);
+	}
+
+	Pipeline.LogTimings(TEXT("MaterialTagGeneratePresetsCommandlet"));
+	UE_LOG(LogTemp, Display, TEXT("MaterialTagGeneratePresetsCommandlet: %d preset(s) with %d tag line(s) written to %s; %d mesh(es) with no tags skipped; waited %.2fs for formatting"),
+		NumWritten, NumTags, *OutputPath, NumUntagged, WaitSeconds);
+
+	return (bLoadedAll && bWritten) ? 0 : 1;
+#else
+	return 1;
+#endif
+}
@@ -0,0 +1,499 @@
+#include "MaterialTagImportDumpCommandlet.h"
+
+#if WITH_EDITOR
+#include "MaterialTagJsonSaxReader.h"
+#include "MaterialTagPresetBlob.h"
+#include "MaterialTagPresetDatabase.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+#include "Algo/Unique.h"
+
+namespace
+{
+	/** Intern a UTF-8 dump string without going through an FString */
+	FName ToName(FUtf8StringView View)
+	{
+		if (View.IsEmpty())
+		{
+			return NAME_None;
+		}
+		auto Wide = StringCast<TCHAR>(View.GetData(), View.Len());
+		return FName(Wide.Length(), Wide.Get());
+	}
+
+	/** A distinct slot layout, shared by every mesh whose slots and tags are identical */
+	struct FLayout
+	{
+		TArray<FName> Slots;
+
+		/** (tag, slot index) pairs, sorted; the dedupe key together with Slots */
+		TArray<TPair<FName, int32>> Tags;
+
+		/** Tag lines as written: tag -> slot names in slot order, sorted by tag */
+		TArray<TPair<FName, TArray<FName>>> TagLines;
+
+		/** Section text after the header line, up to the next header */
+		FString Body;
+	};
+
+	struct FMesh
+	{
+		FString Name;
+		FString FoldedName;
+		int32 Layout = INDEX_NONE;
+	};
+
+	class FPresetCollector
+	{
+	public:
+		/** Add one mesh read from a dump. Sorts and dedupes Tags in place. */
+		void AddMesh(FStringView Name, const TArray<FName>& Slots, TArray<TPair<FName, int32>>& Tags)
+		{
+			// The name has to survive as a section header
+			int32 Unused;
+			if (Name.IsEmpty() || Name.FindChar(TEXT('['), Unused) || Name.FindChar(TEXT(']'), Unused)
+				|| Name.FindChar(TEXT('\n'), Unused) || Name.FindChar(TEXT('\r'), Unused))
+			{
+				NumInvalidNames++;
+				return;
+			}
+
+			Tags.RemoveAll([](const TPair<FName, int32>& Pair) { return Pair.Key.IsNone(); });
+			if (Tags.Num() == 0)
+			{
+				NumUntagged++;
+				return;
+			}
+
+			Tags.Sort([](const TPair<FName, int32>& A, const TPair<FName, int32>& B)
+			{
+				if (A.Key != B.Key)
+				{
+					return FNameLexicalLess()(A.Key, B.Key);
+				}
+				return A.Value < B.Value;
+			});
+			Tags.SetNum(Algo::Unique(Tags), false);
+
+			uint32 Hash = GetTypeHash(Slots.Num());
+			for (const FName& Slot : Slots)
+			{
+				Hash = HashCombine(Hash, GetTypeHash(Slot));
+			}
+			for (const TPair<FName, int32>& Pair : Tags)
+			{
+				Hash = HashCombine(Hash, HashCombine(GetTypeHash(Pair.Key), GetTypeHash(Pair.Value)));
+			}
+
+			int32 LayoutIndex = INDEX_NONE;
+			for (TMultiMap<uint32, int32>::TConstKeyIterator It = LayoutsByHash.CreateConstKeyIterator(Hash); It; ++It)
+			{
+				const FLayout& Layout = Layouts[It.Value()];
+				if (Layout.Slots == Slots && Layout.Tags == Tags)
+				{
+					LayoutIndex = It.Value();
+					break;
+				}
+			}
+
+			// First mesh with this layout: keep a copy and format its body once
+			if (LayoutIndex == INDEX_NONE)
+			{
+				LayoutIndex = Layouts.Num();
+				LayoutsByHash.Add(Hash, LayoutIndex);
+
+				FLayout& Layout = Layouts.AddDefaulted_GetRef();
+				Layout.Slots = Slots;
+				Layout.Tags = Tags;
+				for (const TPair<FName, int32>& Pair : Tags)
+				{
+					if (Layout.TagLines.Num() == 0 || Layout.TagLines.Last().Key != Pair.Key)
+					{
+						Layout.TagLines.Emplace(Pair.Key, TArray<FName>());
+					}
+					// A slot name repeated on the mesh is listed once
+					Layout.TagLines.Last().Value.AddUnique(Slots[Pair.Value]);
+				}
+
+				FMaterialTagPresetDatabase::AppendSectionBody(Layout.Body, Layout.Slots, Layout.TagLines);
+				// The blank line before the next header belongs to this section, as when the INI is indexed
+				Layout.Body += TEXT('\n');
+			}
+
+			FMesh& Mesh = Meshes.AddDefaulted_GetRef();
+			Mesh.Name = FString(Name);
+			Mesh.FoldedName = FMaterialTagPresetDatabase::FoldSectionName(Name);
+			Mesh.Layout = LayoutIndex;
+		}
+
+		TArray<FLayout> Layouts;
+		TArray<FMesh> Meshes;
+
+		int32 NumUntagged = 0;
+		int32 NumInvalidNames = 0;
+
+	private:
+		TMultiMap<uint32, int32> LayoutsByHash;
+	};
+
+	/** Walks the dump's events and hands each finished mesh to the collector; unknown members are skipped */
+	class FDumpHandler final : public FMaterialTagJsonSaxReader::IHandler
+	{
+	public:
+		explicit FDumpHandler(FPresetCollector& InCollector)
+			: Collector(InCollector)
+		{
+		}
+
+		virtual void OnBeginObject() override
+		{
+			const EFrame Parent = GetParent();
+			const EKey Key = TakeKey();
+
+			EFrame Frame = EFrame::Other;
+			if (Frames.Num() == 0)
+			{
+				Frame = EFrame::Root;
+			}
+			else if (Parent == EFrame::Meshes)
+			{
+				Frame = EFrame::Mesh;
+				MeshName.Reset();
+				Slots.Reset();
+				Tags.Reset();
+			}
+			else if (Parent == EFrame::Materials)
+			{
+				Frame = EFrame::Material;
+				SlotName = NAME_None;
+			}
+			else if (Parent == EFrame::Material && Key == EKey::Tags)
+			{
+				Frame = EFrame::TagContainer;
+			}
+			else if (Parent == EFrame::Tags)
+			{
+				Frame = EFrame::TagObject;
+			}
+			Frames.Add(Frame);
+		}
+
+		virtual void OnEndObject() override
+		{
+			PendingKey = EKey::None;
+			const EFrame Frame = Frames.Pop(false);
+			if (Frame == EFrame::Mesh)
+			{
+				Collector.AddMesh(MeshName, Slots, Tags);
+			}
+			else if (Frame == EFrame::Material)
+			{
+				Slots.Add(SlotName);
+			}
+		}
+
+		virtual void OnBeginArray() override
+		{
+			const EFrame Parent = GetParent();
+			const EKey Key = TakeKey();
+
+			EFrame Frame = EFrame::Other;
+			if (Frames.Num() == 0 || (Parent == EFrame::Root && Key == EKey::Meshes))
+			{
+				Frame = EFrame::Meshes;
+			}
+			else if (Parent == EFrame::Mesh && Key == EKey::Materials)
+			{
+				Frame = EFrame::Materials;
+			}
+			else if ((Parent == EFrame::Material || Parent == EFrame::TagContainer) && Key == EKey::Tags)
+			{
+				Frame = EFrame::Tags;
+			}
+			Frames.Add(Frame);
+		}
+
+		virtual void OnEndArray() override
+		{
+			PendingKey = EKey::None;
+			Frames.Pop(false);
+		}
+
+		virtual void OnKey(FUtf8StringView Key) override
+		{
+			PendingKey = ClassifyKey(Key);
+		}
+
+		virtual void OnString(FUtf8StringView Value) override
+		{
+			const EFrame Parent = GetParent();
+			const EKey Key = TakeKey();
+
+			if (Parent == EFrame::Mesh && Key == EKey::Name && MeshName.IsEmpty())
+			{
+				auto Wide = StringCast<TCHAR>(Value.GetData(), Value.Len());
+				MeshName.AppendChars(Wide.Get(), Wide.Length());
+			}
+			else if (Parent == EFrame::Material && Key == EKey::SlotName)
+			{
+				SlotName = ToName(Value);
+			}
+			else if (Parent == EFrame::Tags || (Parent == EFrame::TagObject && Key == EKey::TagName))
+			{
+				// Tags may come before the slot name; the slot is added when its object ends, at this index
+				Tags.Emplace(ToName(Value), Slots.Num());
+			}
+		}
+
+		virtual void OnScalar(FUtf8StringView Value) override
+		{
+			PendingKey = EKey::None;
+		}
+
+	private:
+		enum class EFrame : uint8
+		{
+			Other,
+			Root,
+			Meshes,
+			Mesh,
+			Materials,
+			Material,
+			TagContainer,
+			Tags,
+			TagObject,
+		};
+
+		enum class EKey : uint8
+		{
+			None,
+			Other,
+			Meshes,
+			Name,
+			Materials,
+			SlotName,
+			Tags,
+			TagName,
+		};
+
+		static EKey ClassifyKey(FUtf8StringView Key)
+		{
+			if (Key.Equals(UTF8TEXT("Meshes"))) return EKey::Meshes;
+			if (Key.Equals(UTF8TEXT("Name")) || Key.Equals(UTF8TEXT("ObjectName"))) return EKey::Name;
+			if (Key.Equals(UTF8TEXT("Materials")) || Key.Equals(UTF8TEXT("SkeletalMaterials"))) return EKey::Materials;
+			if (Key.Equals(UTF8TEXT("MaterialSlotName")) || Key.Equals(UTF8TEXT("SlotName"))) return EKey::SlotName;
+			if (Key.Equals(UTF8TEXT("GameplayTagContainer")) || Key.Equals(UTF8TEXT("GameplayTags"))) return EKey::Tags;
+			if (Key.Equals(UTF8TEXT("TagName"))) return EKey::TagName;
+			return EKey::Other;
+		}
+
+		EFrame GetParent() const
+		{
+			return Frames.Num() > 0 ? Frames.Last() : EFrame::Other;
+		}
+
+		EKey TakeKey()
+		{
+			const EKey Key = PendingKey;
+			PendingKey = EKey::None;
+			return Key;
+		}
+
+		FPresetCollector& Collector;
+		TArray<EFrame> Frames;
+		EKey PendingKey = EKey::None;
+
+		// Mesh being read; reused so steady-state parsing doesn't allocate per mesh
+		FString MeshName;
+		TArray<FName> Slots;
+		TArray<TPair<FName, int32>> Tags;
+		FName SlotName;
+	};
+}
+#endif
+
+UMaterialTagImportDumpCommandlet::UMaterialTagImportDumpCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Build a preset INI (and optionally the compiled presets) from JSON dumps of the game's skeletal mesh material tags");
+	HelpUsage = TEXT("-run=MaterialTagImportDump -Input=<dump.json or directory> [-Output=<file>] [-Compile]");
+}
+
+int32 UMaterialTagImportDumpCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString InputPath;
+	if (!FParse::Value(*Params, TEXT("Input="), InputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("MaterialTagImportDumpCommandlet: Missing -Input. Usage: %s"), *HelpUsage);
+		return 1;
+	}
+	InputPath = FPaths::ConvertRelativePathToFull(InputPath);
+
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("MaterialTagPlugin") / TEXT("MaterialTagPresets.ini");
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	OutputPath = FPaths::ConvertRelativePathToFull(OutputPath);
+
+	const bool bCompile = FParse::Param(*Params, TEXT("Compile"));
+
+	TArray<FString> DumpFiles;
+	IFileManager& FileManager = IFileManager::Get();
+	if (FileManager.DirectoryExists(*InputPath))
+	{
+		FileManager.FindFilesRecursive(DumpFiles, *InputPath, TEXT("*.json"), true, false);
+		DumpFiles.Sort();
+	}
+	else if (FileManager.FileExists(*InputPath))
+	{
+		DumpFiles.Add(InputPath);
+	}
+	if (DumpFiles.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MaterialTagImportDumpCommandlet: No dump files at %s"), *InputPath);
+		return 1;
+	}
+
+	// Dumps are read one after another through the same buffers
+	const double ParseStartTime = FPlatformTime::Seconds();
+	FPresetCollector Collector;
+	FMaterialTagJsonSaxReader Reader;
+	int64 NumBytes = 0;
+	int32 NumFailed = 0;
+	for (const FString& DumpFile : DumpFiles)
+	{
+		FDumpHandler Handler(Collector);
+		if (!Reader.Parse(DumpFile, Handler))
+		{
+			UE_LOG(LogTemp, Error, TEXT("MaterialTagImportDumpCommandlet: %s: %s"), *DumpFile, *Reader.GetError());
+			NumFailed++;
+		}
+		NumBytes += Reader.GetBytesRead();
+	}
+	const double ParseSeconds = FPlatformTime::Seconds() - ParseStartTime;
+
+	// Stable, so of two meshes with the same name the one read first is kept
+	const double WriteStartTime = FPlatformTime::Seconds();
+	TArray<FMesh>& Meshes = Collector.Meshes;
+	Meshes.StableSort([](const FMesh& A, const FMesh& B)
+	{
+		return A.FoldedName.Compare(B.FoldedName, ESearchCase::CaseSensitive) < 0;
+	});
+
+	// Sections are streamed out one at a time; only the sorted name list is held
+	const FString TempPath = OutputPath + TEXT(".tmp");
+	TUniquePtr<FArchive> File(FileManager.CreateFileWriter(*TempPath));
+	if (!File.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("MaterialTagImportDumpCommandlet: Could not create %s"), *TempPath);
+		return 1;
+	}
+
+	auto WriteText = [&File](const FString& Text)
+	{
+		FTCHARToUTF8 Utf8(*Text, Text.Len());
+		File->Serialize(const_cast<ANSICHAR*>(reinterpret_cast<const ANSICHAR*>(Utf8.Get())), Utf8.Length());
+	};
+
+	WriteText(FString::Printf(TEXT("; Generated by -run=MaterialTagImportDump from %d dump file(s)\n\n"), DumpFiles.Num()));
+
+	TArray<int32> Written;
+	int32 NumDuplicates = 0;
+	int32 NumConflicting = 0;
+	FString Section;
+	for (int32 Index = 0; Index < Meshes.Num(); Index++)
+	{
+		const FMesh& Mesh = Meshes[Index];
+		if (Written.Num() > 0 && Mesh.FoldedName == Meshes[Written.Last()].FoldedName)
+		{
+			NumDuplicates++;
+			if (Mesh.Layout != Meshes[Written.Last()].Layout)
+			{
+				NumConflicting++;
+				UE_LOG(LogTemp, Verbose, TEXT("MaterialTagImportDumpCommandlet: '%s' appears again with different slot tags; keeping the first"), *Mesh.Name);
+			}
+			continue;
+		}
+
+		Section.Reset();
+		Section += TEXT('[');
+		Section += Mesh.Name;
+		Section += TEXT("]\n");
+		Section += Collector.Layouts[Mesh.Layout].Body;
+		WriteText(Section);
+		Written.Add(Index);
+	}
+
+	bool bWritten = File->Close();
+	File.Reset();
+	bWritten = bWritten && FileManager.Move(*OutputPath, *TempPath, true, true);
+	if (!bWritten)
+	{
+		FileManager.Delete(*TempPath);
+		UE_LOG(LogTemp, Error, TEXT("MaterialTagImportDumpCommandlet: Could not write %s"), *OutputPath);
+	}
+
+	// The blob is stamped with the INI it was compiled from, so the database uses it only while that INI is unchanged
+	bool bCompiled = true;
+	FString BlobPath;
+	if (bWritten && bCompile)
+	{
+		const FFileStatData Stat = FileManager.GetStatData(*OutputPath);
+
+		TArray<TSharedPtr<const FMaterialTagPreset>> Presets;
+		TArray<FString> FoldedNames;
+		Presets.Reserve(Written.Num());
+		FoldedNames.Reserve(Written.Num());
+		for (const int32 Index : Written)
+		{
+			const FMesh& Mesh = Meshes[Index];
+			const FLayout& Layout = Collector.Layouts[Mesh.Layout];
+
+			TSharedPtr<FMaterialTagPreset> Preset = MakeShared<FMaterialTagPreset>();
+			Preset->Name = Mesh.Name;
+			Preset->Slots = Layout.Slots;
+			for (const TPair<FName, TArray<FName>>& TagLine : Layout.TagLines)
+			{
+				FMaterialTagPresetTag& Tag = Preset->Tags.AddDefaulted_GetRef();
+				Tag.TagName = TagLine.Key;
+				Tag.Slots = TagLine.Value;
+			}
+			Preset->ContentHash = FMaterialTagPresetDatabase::HashSection(Mesh.Name, Layout.Body);
+
+			Presets.Add(MoveTemp(Preset));
+			FoldedNames.Add(Mesh.FoldedName);
+		}
+
+		TArray<uint8> Blob;
+		FMaterialTagPresetBlob::Compile(Presets, FoldedNames, Stat.ModificationTime.GetTicks(), Stat.FileSize, Blob);
+
+		BlobPath = FPaths::IsSamePath(OutputPath, FMaterialTagPresetDatabase::GetPresetIniPath())
+			? FMaterialTagPresetDatabase::GetCompiledPresetPath()
+			: FPaths::ChangeExtension(OutputPath, TEXT("bin"));
+		bCompiled = FFileHelper::SaveArrayToFile(Blob, *BlobPath);
+		if (!bCompiled)
+		{
+			UE_LOG(LogTemp, Error, TEXT("MaterialTagImportDumpCommandlet: Could not write %s"), *BlobPath);
+		}
+	}
+	const double WriteSeconds = FPlatformTime::Seconds() - WriteStartTime;
+
+	const double MegaBytes = NumBytes / (1024.0 * 1024.0);
+	UE_LOG(LogTemp, Display, TEXT("MaterialTagImportDumpCommandlet: %d dump file(s), %.1f MB parsed in %.2fs (%.1f MB/s), %d failed"),
+		DumpFiles.Num(), MegaBytes, ParseSeconds, ParseSeconds > 0.0 ? MegaBytes / ParseSeconds : 0.0, NumFailed);
+	UE_LOG(LogTemp, Display, TEXT("MaterialTagImportDumpCommandlet: %d tagged mesh(es) share %d distinct slot layout(s); %d without tags, %d with unusable names"),
+		Meshes.Num(), Collector.Layouts.Num(), Collector.NumUntagged, Collector.NumInvalidNames);
+	UE_LOG(LogTemp, Display, TEXT("MaterialTagImportDumpCommandlet: %d preset(s) written to %s in %.2fs; %d repeated name(s) dropped, %d with different slot tags%s%s"),
+		Written.Num(), *OutputPath, WriteSeconds, NumDuplicates, NumConflicting,
+		BlobPath.IsEmpty() ? TEXT("") : TEXT("; compiled to "), *BlobPath);
+
+	return (NumFailed == 0 && bWritten && bCompiled) ? 0 : 1;
+#else
+	return 1;
+#endif
+}
@@ -0,0 +1,405 @@
+#include "MaterialTagJsonSaxReader.h"
+
+#if WITH_EDITOR
+
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+	bool IsScalarChar(uint8 Char)
+	{
+		return (Char >= '0' && Char <= '9') || (Char >= 'a' && Char <= 'z') || (Char >= 'A' && Char <= 'Z')
+			|| Char == '-' || Char == '+' || Char == '.';
+	}
+}
+
+FMaterialTagJsonSaxReader::FMaterialTagJsonSaxReader(int32 InBufferSize)
+	: BufferSize(FMath::Max(InBufferSize, 4096))
+{
+}
+
+FMaterialTagJsonSaxReader::~FMaterialTagJsonSaxReader() = default;
+
+bool FMaterialTagJsonSaxReader::Parse(const FString& Filename, IHandler& Handler)
+{
+	enum class EExpect : uint8
+	{
+		Value,
+		ValueOrEnd,
+		Key,
+		KeyOrEnd,
+		Colon,
+		CommaOrEnd,
+		Done,
+	};
+
+	Error.Reset();
+	Stack.Reset();
+	Pos = 0;
+	Len = 0;
+	BufferOffset = 0;
+
+	File.Reset(IFileManager::Get().CreateFileReader(*Filename));
+	if (!File.IsValid())
+	{
+		Error = FString::Printf(TEXT("Could not open '%s'"), *Filename);
+		return false;
+	}
+	FileSize = File->TotalSize();
+	Buffer.SetNumUninitialized(BufferSize);
+
+	// Skip a UTF-8 byte order mark; the buffer always holds the first 4 KB whole
+	if (Fill() && Len >= 3 && Buffer[0] == 0xEF && Buffer[1] == 0xBB && Buffer[2] == 0xBF)
+	{
+		Pos = 3;
+	}
+
+	EExpect Expect = EExpect::Value;
+	auto EndValue = [this, &Expect]()
+	{
+		Expect = Stack.Num() > 0 ? EExpect::CommaOrEnd : EExpect::Done;
+	};
+	auto CloseContainer = [this, &Handler, &EndValue]()
+	{
+		Pos++;
+		if (Stack.Pop(false))
+		{
+			Handler.OnEndObject();
+		}
+		else
+		{
+			Handler.OnEndArray();
+		}
+		EndValue();
+	};
+
+	while (SkipWhitespace())
+	{
+		const uint8 Char = Buffer[Pos];
+		switch (Expect)
+		{
+		case EExpect::Done:
+			return Fail(TEXT("Unexpected data after the top-level value"));
+
+		case EExpect::Colon:
+			if (Char != ':')
+			{
+				return Fail(TEXT("Expected ':'"));
+			}
+			Pos++;
+			Expect = EExpect::Value;
+			break;
+
+		case EExpect::CommaOrEnd:
+			if (Char == ',')
+			{
+				Pos++;
+				Expect = Stack.Last() ? EExpect::Key : EExpect::Value;
+			}
+			else if (Char == (Stack.Last() ? '}' : ']'))
+			{
+				CloseContainer();
+			}
+			else
+			{
+				return Fail(TEXT("Expected ',' or the end of the container"));
+			}
+			break;
+
+		case EExpect::Key:
+		case EExpect::KeyOrEnd:
+			if (Expect == EExpect::KeyOrEnd && Char == '}')
+			{
+				CloseContainer();
+				break;
+			}
+			if (Char != '"')
+			{
+				return Fail(TEXT("Expected a member name"));
+			}
+			if (!ReadString())
+			{
+				return false;
+			}
+			Handler.OnKey(FUtf8StringView(Scratch.GetData(), Scratch.Num()));
+			Expect = EExpect::Colon;
+			break;
+
+		case EExpect::Value:
+		case EExpect::ValueOrEnd:
+			if (Expect == EExpect::ValueOrEnd && Char == ']')
+			{
+				CloseContainer();
+			}
+			else if (Char == '{' || Char == '[')
+			{
+				if (Stack.Num() >= MaxDepth)
+				{
+					return Fail(TEXT("Nesting too deep"));
+				}
+				Pos++;
+				const bool bObject = Char == '{';
+				Stack.Add(bObject);
+				if (bObject)
+				{
+					Handler.OnBeginObject();
+				}
+				else
+				{
+					Handler.OnBeginArray();
+				}
+				Expect = bObject ? EExpect::KeyOrEnd : EExpect::ValueOrEnd;
+			}
+			else if (Char == '"')
+			{
+				if (!ReadString())
+				{
+					return false;
+				}
+				Handler.OnString(FUtf8StringView(Scratch.GetData(), Scratch.Num()));
+				EndValue();
+			}
+			else
+			{
+				if (!ReadScalar())
+				{
+					return false;
+				}
+				Handler.OnScalar(FUtf8StringView(Scratch.GetData(), Scratch.Num()));
+				EndValue();
+			}
+			break;
+		}
+	}
+
+	// A read error ends the loop like the end of the file does
+	if (!Error.IsEmpty())
+	{
+		return false;
+	}
+	if (Expect != EExpect::Done)
+	{
+		return Fail(TEXT("Unexpected end of file"));
+	}
+
+	File.Reset();
+	return true;
+}
+
+bool FMaterialTagJsonSaxReader::Fill()
+{
+	if (Pos < Len)
+	{
+		return true;
+	}
+	if (!File.IsValid())
+	{
+		return false;
+	}
+
+	const int64 Remaining = FileSize - (BufferOffset + Len);
+	if (Remaining <= 0)
+	{
+		return false;
+	}
+
+	BufferOffset += Len;
+	Pos = 0;
+	Len = (int32)FMath::Min<int64>(Remaining, BufferSize);
+	File->Serialize(Buffer.GetData(), Len);
+	if (File->IsError())
+	{
+		Len = 0;
+		Fail(TEXT("Read error"));
+		return false;
+	}
+	return true;
+}
+
+bool FMaterialTagJsonSaxReader::SkipWhitespace()
+{
+	while (Fill())
+	{
+		const uint8 Char = Buffer[Pos];
+		if (Char != ' ' && Char != '\t' && Char != '\n' && Char != '\r')
+		{
+			return true;
+		}
+		Pos++;
+	}
+	return false;
+}
+
+bool FMaterialTagJsonSaxReader::ReadString()
+{
+	// Opening quote
+	Pos++;
+	Scratch.Reset();
+
+	for (;;)
+	{
+		if (!Fill())
+		{
+			return Fail(TEXT("Unterminated string"));
+		}
+
+		// Copy the plain run up to the next quote or escape in one go
+		const int32 RunStart = Pos;
+		while (Pos < Len && Buffer[Pos] != '"' && Buffer[Pos] != '\\')
+		{
+			Pos++;
+		}
+		Scratch.Append(reinterpret_cast<const UTF8CHAR*>(Buffer.GetData() + RunStart), Pos - RunStart);
+		if (Pos == Len)
+		{
+			continue;
+		}
+
+		if (Buffer[Pos++] == '"')
+		{
+			return true;
+		}
+
+		if (!Fill())
+		{
+			return Fail(TEXT("Unterminated string"));
+		}
+		const uint8 Escape = Buffer[Pos++];
+		switch (Escape)
+		{
+		case '"':
+		case '\\':
+		case '/':
+			Scratch.Add((UTF8CHAR)Escape);
+			break;
+		case 'b': Scratch.Add((UTF8CHAR)'\b'); break;
+		case 'f': Scratch.Add((UTF8CHAR)'\f'); break;
+		case 'n': Scratch.Add((UTF8CHAR)'\n'); break;
+		case 'r': Scratch.Add((UTF8CHAR)'\r'); break;
+		case 't': Scratch.Add((UTF8CHAR)'\t'); break;
+		case 'u':
+		{
+			uint32 Codepoint = 0;
+			if (!ReadHex4(Codepoint))
+			{
+				return false;
+			}
+
+			// A high surrogate must be followed by an escaped low surrogate
+			if (Codepoint >= 0xD800 && Codepoint <= 0xDBFF)
+			{
+				uint32 Low = 0;
+				if (!Fill() || Buffer[Pos++] != '\\' || !Fill() || Buffer[Pos++] != 'u' || !ReadHex4(Low))
+				{
+					return Fail(TEXT("Unpaired surrogate in string"));
+				}
+				if (Low < 0xDC00 || Low > 0xDFFF)
+				{
+					return Fail(TEXT("Unpaired surrogate in string"));
+				}
+				Codepoint = 0x10000 + ((Codepoint - 0xD800) << 10) + (Low - 0xDC00);
+			}
+			else if (Codepoint >= 0xDC00 && Codepoint <= 0xDFFF)
+			{
+				return Fail(TEXT("Unpaired surrogate in string"));
+			}
+			AppendCodepoint(Codepoint);
+			break;
+		}
+		default:
+			return Fail(TEXT("Invalid escape in string"));
+		}
+	}
+}
+
+bool FMaterialTagJsonSaxReader::ReadScalar()
+{
+	Scratch.Reset();
+	while (Fill() && IsScalarChar(Buffer[Pos]))
+	{
+		Scratch.Add((UTF8CHAR)Buffer[Pos++]);
+	}
+
+	if (!Error.IsEmpty())
+	{
+		return false;
+	}
+	if (Scratch.Num() == 0)
+	{
+		return Fail(TEXT("Unexpected character"));
+	}
+	return true;
+}
+
+bool FMaterialTagJsonSaxReader::ReadHex4(uint32& OutValue)
+{
+	OutValue = 0;
+	for (int32 Digit = 0; Digit < 4; Digit++)
+	{
+		if (!Fill())
+		{
+			return Fail(TEXT("Unterminated \\u escape"));
+		}
+
+		const uint8 Char = Buffer[Pos++];
+		uint32 Value;
+		if (Char >= '0' && Char <= '9')
+		{
+			Value = Char - '0';
+		}
+		else if (Char >= 'a' && Char <= 'f')
+		{
+			Value = Char - 'a' + 10;
+		}
+		else if (Char >= 'A' && Char <= 'F')
+		{
+			Value = Char - 'A' + 10;
+		}
+		else
+		{
+			return Fail(TEXT("Invalid \\u escape"));
+		}
+		OutValue = (OutValue << 4) | Value;
+	}
+	return true;
+}
+
+void FMaterialTagJsonSaxReader::AppendCodepoint(uint32 Codepoint)
+{
+	if (Codepoint < 0x80)
+	{
+		Scratch.Add((UTF8CHAR)Codepoint);
+	}
+	else if (Codepoint < 0x800)
+	{
+		Scratch.Add((UTF8CHAR)(0xC0 | (Codepoint >> 6)));
+		Scratch.Add((UTF8CHAR)(0x80 | (Codepoint & 0x3F)));
+	}
+	else if (Codepoint < 0x10000)
+	{
+		Scratch.Add((UTF8CHAR)(0xE0 | (Codepoint >> 12)));
+		Scratch.Add((UTF8CHAR)(0x80 | ((Codepoint >> 6) & 0x3F)));
+		Scratch.Add((UTF8CHAR)(0x80 | (Codepoint & 0x3F)));
+	}
+	else
+	{
+		Scratch.Add((UTF8CHAR)(0xF0 | (Codepoint >> 18)));
+		Scratch.Add((UTF8CHAR)(0x80 | ((Codepoint >> 12) & 0x3F)));
+		Scratch.Add((UTF8CHAR)(0x80 | ((Codepoint >> 6) & 0x3F)));
+		Scratch.Add((UTF8CHAR)(0x80 | (Codepoint & 0x3F)));
+	}
+}
+
+bool FMaterialTagJsonSaxReader::Fail(const TCHAR* Message)
+{
+	// Keep the first error; later ones are consequences of it
+	if (Error.IsEmpty())
+	{
+		Error = FString::Printf(TEXT("%s at byte %lld"), Message, GetBytesRead());
+	}
+	File.Reset();
+	return false;
+}
+
+#endif // WITH_EDITOR
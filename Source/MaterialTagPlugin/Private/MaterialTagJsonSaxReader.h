@@ -0,0 +1,93 @@
+#pragma once
+
+#if WITH_EDITOR
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+
+class FArchive;
+
+/**
+ * Streaming (SAX-style) JSON reader for dump files too large to hold as a DOM.
+ *
+ * The file is read through one fixed-size buffer and every key and value is handed to the handler
+ * as a UTF-8 view into a reused scratch buffer, valid only for the duration of the callback.
+ * After the first few tokens parsing allocates nothing, whatever the size of the file.
+ * Nesting is tracked with an explicit stack, so deep documents cannot overflow the call stack.
+ */
+class FMaterialTagJsonSaxReader
+{
+public:
+	class IHandler
+	{
+	public:
+		virtual ~IHandler() = default;
+
+		virtual void OnBeginObject() = 0;
+		virtual void OnEndObject() = 0;
+		virtual void OnBeginArray() = 0;
+		virtual void OnEndArray() = 0;
+
+		/** Object member name; the member's value follows */
+		virtual void OnKey(FUtf8StringView Key) = 0;
+
+		/** String value, escapes decoded */
+		virtual void OnString(FUtf8StringView Value) = 0;
+
+		/** Number, true, false or null, as written */
+		virtual void OnScalar(FUtf8StringView Value) = 0;
+	};
+
+	explicit FMaterialTagJsonSaxReader(int32 InBufferSize = 1 << 20);
+	~FMaterialTagJsonSaxReader();
+
+	/** Parse one file into Handler. Returns false on a read or syntax error; GetError then describes it. */
+	bool Parse(const FString& Filename, IHandler& Handler);
+
+	const FString& GetError() const { return Error; }
+
+	/** Bytes consumed by the last Parse */
+	int64 GetBytesRead() const { return BufferOffset + Pos; }
+
+	/** Deepest nesting accepted; deeper documents are rejected rather than growing the stack without bound */
+	static constexpr int32 MaxDepth = 256;
+
+private:
+	/** Make the next byte available. Returns false at end of file. */
+	bool Fill();
+
+	/** Skip whitespace. Returns false at end of file. */
+	bool SkipWhitespace();
+
+	/** Read a string whose opening quote is the current byte into Scratch */
+	bool ReadString();
+
+	/** Read a number or literal starting at the current byte into Scratch */
+	bool ReadScalar();
+
+	bool ReadHex4(uint32& OutValue);
+	void AppendCodepoint(uint32 Codepoint);
+
+	/** Record the first error, with the offset it happened at, and release the file */
+	bool Fail(const TCHAR* Message);
+
+	TUniquePtr<FArchive> File;
+	int64 FileSize = 0;
+
+	TArray<uint8> Buffer;
+	int32 BufferSize;
+	int32 Pos = 0;
+	int32 Len = 0;
+
+	/** File offset of Buffer[0] */
+	int64 BufferOffset = 0;
+
+	TArray<UTF8CHAR> Scratch;
+
+	/** Open containers; true for objects */
+	TArray<bool> Stack;
+
+	FString Error;
+};
+
+#endif // WITH_EDITOR
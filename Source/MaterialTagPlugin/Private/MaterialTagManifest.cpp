@@ -0,0 +1,398 @@
+#include "MaterialTagManifest.h"
+
+#if WITH_EDITOR
+
+#include "MaterialTagAssetUserData.h"
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+	/** Fixed part of the header: Magic, Version, NumMeshes, NumStrings, StringTableOffset */
+	constexpr int32 HeaderSize = 4 * sizeof(uint32) + sizeof(uint64);
+}
+
+FMaterialTagManifestWriter::FMaterialTagManifestWriter(int32 InChunkSize)
+	: ChunkSize(FMath::Max(InChunkSize, 4096))
+{
+}
+
+FMaterialTagManifestWriter::~FMaterialTagManifestWriter()
+{
+	// Abandoned without Close: leave no temporary file behind
+	if (File.IsValid())
+	{
+		File.Reset();
+		IFileManager::Get().Delete(*TempFilename);
+	}
+}
+
+bool FMaterialTagManifestWriter::Open(const FString& InFilename, TConstArrayView<FName> SeedStrings)
+{
+	Filename = InFilename;
+	TempFilename = Filename + TEXT(".tmp");
+
+	File.Reset(IFileManager::Get().CreateFileWriter(*TempFilename));
+	if (!File.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("MaterialTagManifestWriter: Could not create '%s'"), *TempFilename);
+		return false;
+	}
+
+	Chunk.Reserve(ChunkSize);
+	Strings.Reset();
+	Strings.Append(SeedStrings.GetData(), SeedStrings.Num());
+	ReferencedStrings.Init(false, Strings.Num());
+	StringIds.Reset();
+	StringIds.Reserve(Strings.Num());
+	for (int32 Id = 0; Id < Strings.Num(); Id++)
+	{
+		// Names that differ only by case share an id for new records; old records keep theirs
+		if (!StringIds.Contains(Strings[Id]))
+		{
+			StringIds.Add(Strings[Id], Id);
+		}
+	}
+	NumMeshes = 0;
+
+	// Placeholder header; Close fills in the counts and the string table offset
+	Chunk.AddZeroed(HeaderSize);
+	return true;
+}
+
+void FMaterialTagManifestWriter::AddMesh(FName PackageName, TConstArrayView<FMaterialTagRegistrySlot> Slots)
+{
+	check(File.IsValid());
+
+	const int32 SizeOffset = Chunk.Num();
+	WriteUInt32(0);
+
+	TStringBuilder<256> PackagePath;
+	PackageName.AppendString(PackagePath);
+	WriteUtf8(PackagePath.ToView());
+
+	WriteUInt32(Slots.Num());
+	for (const FMaterialTagRegistrySlot& Slot : Slots)
+	{
+		WriteUInt32(Slot.SlotIndex);
+		WriteUInt32(InternString(Slot.SlotName));
+		WriteUInt32(Slot.Tags.Num());
+		for (const FGameplayTag& Tag : Slot.Tags)
+		{
+			WriteUInt32(InternString(Tag.GetTagName()));
+		}
+	}
+
+	// Records are only flushed between AddMesh calls, so the size field is still in the chunk
+	const uint32 RecordSize = Chunk.Num() - SizeOffset - sizeof(uint32);
+	FMemory::Memcpy(Chunk.GetData() + SizeOffset, &RecordSize, sizeof(uint32));
+	NumMeshes++;
+
+	if (Chunk.Num() >= ChunkSize)
+	{
+		FlushChunk();
+	}
+}
+
+void FMaterialTagManifestWriter::AddRawRecords(TConstArrayView<uint8> Records, int32 NumRecords)
+{
+	check(File.IsValid());
+
+	Chunk.Append(Records.GetData(), Records.Num());
+	NumMeshes += NumRecords;
+	MarkRecordStrings(Records);
+
+	if (Chunk.Num() >= ChunkSize)
+	{
+		FlushChunk();
+	}
+}
+
+uint64 FMaterialTagManifestWriter::GetOffset() const
+{
+	return File.IsValid() ? File->Tell() + Chunk.Num() : 0;
+}
+
+bool FMaterialTagManifestWriter::Close()
+{
+	check(File.IsValid());
+
+	FlushChunk();
+	uint64 StringTableOffset = File->Tell();
+
+	TStringBuilder<256> Text;
+	for (const FName& String : Strings)
+	{
+		Text.Reset();
+		String.AppendString(Text);
+		WriteUtf8(Text.ToView());
+		if (Chunk.Num() >= ChunkSize)
+		{
+			FlushChunk();
+		}
+	}
+	FlushChunk();
+
+	uint32 HeaderMagic = Magic;
+	uint32 HeaderVersion = Version;
+	uint32 HeaderNumMeshes = NumMeshes;
+	uint32 HeaderNumStrings = Strings.Num();
+	File->Seek(0);
+	*File << HeaderMagic << HeaderVersion << HeaderNumMeshes << HeaderNumStrings << StringTableOffset;
+
+	const bool bWriteOk = !File->IsError() && File->Close();
+	File.Reset();
+
+	if (!bWriteOk)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MaterialTagManifestWriter: Write to '%s' failed"), *TempFilename);
+		IFileManager::Get().Delete(*TempFilename);
+		return false;
+	}
+	if (!IFileManager::Get().Move(*Filename, *TempFilename, true, true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("MaterialTagManifestWriter: Could not replace '%s'"), *Filename);
+		IFileManager::Get().Delete(*TempFilename);
+		return false;
+	}
+	return true;
+}
+
+uint32 FMaterialTagManifestWriter::InternString(FName Name)
+{
+	if (const uint32* Existing = StringIds.Find(Name))
+	{
+		ReferencedStrings[*Existing] = true;
+		return *Existing;
+	}
+	const uint32 Id = Strings.Add(Name);
+	StringIds.Add(Name, Id);
+	ReferencedStrings.Add(true);
+	return Id;
+}
+
+void FMaterialTagManifestWriter::MarkRecordStrings(TConstArrayView<uint8> Records)
+{
+	int64 Pos = 0;
+	auto ReadUInt32 = [&Records, &Pos](uint32& OutValue)
+	{
+		if (Pos + (int64)sizeof(uint32) > Records.Num())
+		{
+			return false;
+		}
+		FMemory::Memcpy(&OutValue, Records.GetData() + Pos, sizeof(uint32));
+		Pos += sizeof(uint32);
+		return true;
+	};
+	auto Mark = [this](uint32 Id)
+	{
+		if (Id < (uint32)ReferencedStrings.Num())
+		{
+			ReferencedStrings[Id] = true;
+		}
+	};
+
+	uint32 RecordSize = 0;
+	while (ReadUInt32(RecordSize))
+	{
+		const int64 RecordEnd = Pos + RecordSize;
+
+		uint32 PathLength = 0;
+		uint32 NumSlots = 0;
+		if (!ReadUInt32(PathLength)) return;
+		Pos += PathLength;
+		if (!ReadUInt32(NumSlots)) return;
+
+		for (uint32 Slot = 0; Slot < NumSlots && Pos < RecordEnd; Slot++)
+		{
+			uint32 SlotIndex = 0;
+			uint32 SlotNameId = 0;
+			uint32 NumTags = 0;
+			if (!ReadUInt32(SlotIndex) || !ReadUInt32(SlotNameId) || !ReadUInt32(NumTags)) return;
+			Mark(SlotNameId);
+
+			for (uint32 Tag = 0; Tag < NumTags && Pos < RecordEnd; Tag++)
+			{
+				uint32 TagId = 0;
+				if (!ReadUInt32(TagId)) return;
+				Mark(TagId);
+			}
+		}
+		Pos = RecordEnd;
+	}
+}
+
+void FMaterialTagManifestWriter::WriteUInt32(uint32 Value)
+{
+	Chunk.Append(reinterpret_cast<const uint8*>(&Value), sizeof(uint32));
+}
+
+void FMaterialTagManifestWriter::WriteUtf8(FStringView Text)
+{
+	const FTCHARToUTF8 Utf8(Text.GetData(), Text.Len());
+	WriteUInt32(Utf8.Length());
+	Chunk.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+}
+
+void FMaterialTagManifestWriter::FlushChunk()
+{
+	if (Chunk.Num() > 0)
+	{
+		File->Serialize(Chunk.GetData(), Chunk.Num());
+		Chunk.Reset();
+	}
+}
+
+FMaterialTagManifestReader::~FMaterialTagManifestReader()
+{
+	Close();
+}
+
+bool FMaterialTagManifestReader::Open(const FString& Filename)
+{
+	Close();
+	Strings.Reset();
+	NumMeshes = 0;
+
+	File.Reset(IFileManager::Get().CreateFileReader(*Filename));
+	if (!File.IsValid()) return false;
+
+	FileSize = File->TotalSize();
+	if (FileSize < HeaderSize)
+	{
+		Close();
+		return false;
+	}
+
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	uint32 FileNumMeshes = 0;
+	uint32 NumStrings = 0;
+	uint64 StringTableOffset = 0;
+	*File << FileMagic << FileVersion << FileNumMeshes << NumStrings << StringTableOffset;
+	if (FileMagic != FMaterialTagManifestWriter::Magic || FileVersion != FMaterialTagManifestWriter::Version
+		|| StringTableOffset < HeaderSize || StringTableOffset > (uint64)FileSize)
+	{
+		Close();
+		return false;
+	}
+	NumMeshes = FileNumMeshes;
+
+	// Every string takes at least its length prefix; a count the rest of the file can't hold is corrupt
+	if (NumStrings > ((uint64)FileSize - StringTableOffset) / sizeof(uint32))
+	{
+		Close();
+		return false;
+	}
+
+	File->Seek(StringTableOffset);
+	TArray<UTF8CHAR> Utf8;
+	Strings.Reserve(NumStrings);
+	for (uint32 Index = 0; Index < NumStrings; Index++)
+	{
+		uint32 Length = 0;
+		*File << Length;
+		if (File->IsError() || File->Tell() + Length > FileSize)
+		{
+			Close();
+			return false;
+		}
+		Utf8.SetNumUninitialized(Length);
+		File->Serialize(Utf8.GetData(), Length);
+		auto Wide = StringCast<TCHAR>(Utf8.GetData(), Length);
+		Strings.Add(FName(Wide.Length(), Wide.Get()));
+	}
+	return !File->IsError();
+}
+
+bool FMaterialTagManifestReader::ReadRecords(uint64 Offset, uint32 Size, TArray<uint8>& OutBytes)
+{
+	if (!File.IsValid() || Offset + Size > (uint64)FileSize) return false;
+
+	OutBytes.SetNumUninitialized(Size);
+	File->Seek(Offset);
+	File->Serialize(OutBytes.GetData(), Size);
+	return !File->IsError();
+}
+
+void FMaterialTagManifestReader::Close()
+{
+	if (File.IsValid())
+	{
+		File->Close();
+		File.Reset();
+	}
+}
+
+FString FMaterialTagManifestCache::GetCachePath(const FString& ManifestPath)
+{
+	return ManifestPath + TEXT(".cache");
+}
+
+bool FMaterialTagManifestCache::Load(const FString& Filename)
+{
+	Entries.Reset();
+	ManifestSize = 0;
+	NumUnreferencedStrings = 0;
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!Reader.IsValid()) return false;
+
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	int32 NumEntries = 0;
+	*Reader << FileMagic << FileVersion;
+	if (FileMagic != Magic || FileVersion != Version) return false;
+
+	*Reader << ManifestSize << NumUnreferencedStrings << NumEntries;
+
+	// Smallest entry: an empty package name's length prefix, the saved hash, then SlotTagsHash, RecordOffset, RecordSize and NumRecords
+	constexpr int64 MinEntrySize = sizeof(int32) + sizeof(FIoHash) + sizeof(uint32) + sizeof(uint64) + sizeof(uint32) + sizeof(int32);
+	if (Reader->IsError() || NumEntries < 0 || NumEntries > (Reader->TotalSize() - Reader->Tell()) / MinEntrySize)
+	{
+		ManifestSize = 0;
+		NumUnreferencedStrings = 0;
+		return false;
+	}
+	Entries.Reserve(NumEntries);
+	for (int32 Index = 0; Index < NumEntries && !Reader->IsError(); Index++)
+	{
+		FString PackageName;
+		FEntry Entry;
+		*Reader << PackageName << Entry.PackageSavedHash << Entry.SlotTagsHash << Entry.RecordOffset << Entry.RecordSize << Entry.NumRecords;
+		Entries.Add(FName(*PackageName), Entry);
+	}
+
+	if (Reader->IsError())
+	{
+		Entries.Reset();
+		ManifestSize = 0;
+		NumUnreferencedStrings = 0;
+		return false;
+	}
+	return true;
+}
+
+bool FMaterialTagManifestCache::Save(const FString& Filename) const
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Writer.IsValid()) return false;
+
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	int64 FileManifestSize = ManifestSize;
+	int32 FileNumUnreferencedStrings = NumUnreferencedStrings;
+	int32 NumEntries = Entries.Num();
+	*Writer << FileMagic << FileVersion << FileManifestSize << FileNumUnreferencedStrings << NumEntries;
+
+	for (const TPair<FName, FEntry>& Pair : Entries)
+	{
+		FString PackageName = Pair.Key.ToString();
+		FEntry Entry = Pair.Value;
+		*Writer << PackageName << Entry.PackageSavedHash << Entry.SlotTagsHash << Entry.RecordOffset << Entry.RecordSize << Entry.NumRecords;
+	}
+
+	return !Writer->IsError() && Writer->Close();
+}
+
+#endif // WITH_EDITOR
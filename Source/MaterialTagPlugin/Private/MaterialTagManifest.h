@@ -0,0 +1,160 @@
+#pragma once
+
+#if WITH_EDITOR
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include "IO/IoHash.h"
+
+class FArchive;
+struct FMaterialTagRegistrySlot;
+
+/**
+ * Streaming writer for the slot-tag manifest UAssetTool reads instead of opening every cooked package.
+ *
+ * Layout (little endian, offsets from the start of the file):
+ *   uint32 Magic ("MTMF"), uint32 Version, uint32 NumMeshes, uint32 NumStrings, uint64 StringTableOffset
+ *   NumMeshes mesh records, sorted by package path:
+ *     uint32 RecordSize                        - bytes in the record after this field
+ *     uint32 PackagePathLength, UTF8 PackagePath[PackagePathLength]
+ *     uint32 NumSlots
+ *     NumSlots x { uint32 SlotIndex, uint32 SlotNameId, uint32 NumTags, uint32 TagIds[NumTags] }
+ *   String table at StringTableOffset, NumStrings x { uint32 Length, UTF8 Bytes[Length] }
+ *
+ * Slot and tag names are ids into the string table, which is written last so records can be
+ * streamed as they are produced. Records pass through a fixed-size chunk buffer; only the
+ * string table (distinct slot and tag names) grows with the project.
+ *
+ * A writer seeded with an older manifest's strings keeps all of them, referenced or not, so the
+ * writer counts which ids its records use; see GetNumUnreferencedStrings.
+ *
+ * The file is written under a temporary name and moved into place by Close, so readers never see a partial manifest.
+ */
+class FMaterialTagManifestWriter
+{
+public:
+	static constexpr uint32 Magic = 0x464D544D;
+	static constexpr uint32 Version = 1;
+
+	explicit FMaterialTagManifestWriter(int32 InChunkSize = 1 << 20);
+	~FMaterialTagManifestWriter();
+
+	/**
+	 * Start writing. Returns false if the temporary file can't be created.
+	 * SeedStrings become string ids 0..N-1, so records copied from a manifest with that string table stay valid.
+	 */
+	bool Open(const FString& InFilename, TConstArrayView<FName> SeedStrings = {});
+
+	/** Append one mesh; slots in material index order */
+	void AddMesh(FName PackageName, TConstArrayView<FMaterialTagRegistrySlot> Slots);
+
+	/** Append whole records verbatim, as read from a manifest whose string table seeded this writer */
+	void AddRawRecords(TConstArrayView<uint8> Records, int32 NumRecords);
+
+	/** File offset the next record will be written at */
+	uint64 GetOffset() const;
+
+	/** Write the string table and header and move the file into place. Returns false on any write error. */
+	bool Close();
+
+	int32 GetNumMeshes() const { return NumMeshes; }
+	int32 GetNumStrings() const { return Strings.Num(); }
+
+	/** Strings in the table that no record written so far refers to; only seeded strings can be unreferenced */
+	int32 GetNumUnreferencedStrings() const { return Strings.Num() - ReferencedStrings.CountSetBits(); }
+
+private:
+	uint32 InternString(FName Name);
+
+	/** Mark the string ids used by whole records */
+	void MarkRecordStrings(TConstArrayView<uint8> Records);
+
+	void WriteUInt32(uint32 Value);
+	void WriteUtf8(FStringView Text);
+	void FlushChunk();
+
+	FString Filename;
+	FString TempFilename;
+	TUniquePtr<FArchive> File;
+
+	/** Pending bytes; flushed to File whenever it reaches ChunkSize */
+	TArray<uint8> Chunk;
+	int32 ChunkSize;
+
+	TArray<FName> Strings;
+	TMap<FName, uint32> StringIds;
+
+	/** One bit per string id, set once a record refers to it */
+	TBitArray<> ReferencedStrings;
+
+	int32 NumMeshes = 0;
+};
+
+/** Random access to an existing manifest: its string table and raw record bytes */
+class FMaterialTagManifestReader
+{
+public:
+	~FMaterialTagManifestReader();
+
+	/** Read the header and string table. Returns false if the file is missing or not a current-version manifest. */
+	bool Open(const FString& Filename);
+
+	/** Copy Size bytes of records starting at Offset */
+	bool ReadRecords(uint64 Offset, uint32 Size, TArray<uint8>& OutBytes);
+
+	/** Release the file handle */
+	void Close();
+
+	const TArray<FName>& GetStrings() const { return Strings; }
+	int32 GetNumMeshes() const { return NumMeshes; }
+
+	/** Size of the manifest on disk; ties a cache to the manifest it was written with */
+	int64 GetFileSize() const { return FileSize; }
+
+private:
+	TUniquePtr<FArchive> File;
+	TArray<FName> Strings;
+	int32 NumMeshes = 0;
+	int64 FileSize = 0;
+};
+
+/**
+ * Sidecar of the manifest for incremental export, keyed by package.
+ * Remembers where each package's records sit in the manifest and the hashes they were produced from.
+ */
+struct FMaterialTagManifestCache
+{
+	struct FEntry
+	{
+		/** Asset registry package saved hash at export time */
+		FIoHash PackageSavedHash;
+
+		/** Hash of the package's MaterialTagSlotTags registry values */
+		uint32 SlotTagsHash = 0;
+
+		/** Byte range of the package's records in the manifest */
+		uint64 RecordOffset = 0;
+		uint32 RecordSize = 0;
+		int32 NumRecords = 0;
+	};
+
+	static constexpr uint32 Magic = 0x434D544D;
+	static constexpr uint32 Version = 2;
+
+	/** Manifest file size the entries refer to */
+	int64 ManifestSize = 0;
+
+	/** Strings in that manifest's table that none of its records use */
+	int32 NumUnreferencedStrings = 0;
+
+	TMap<FName, FEntry> Entries;
+
+	/** Sidecar path for a manifest */
+	static FString GetCachePath(const FString& ManifestPath);
+
+	/** Returns false (and leaves the cache empty) if the file is missing, unreadable or from another version */
+	bool Load(const FString& Filename);
+	bool Save(const FString& Filename) const;
+};
+
+#endif // WITH_EDITOR
@@ -1,16 +1,55 @@
 #include "MaterialTagPlugin.h"
 #include "MaterialTagAssetUserData.h"
+#include "MaterialTagPresetDatabase.h"
+#include "UObject/CoreRedirects.h"
 
 #if WITH_EDITOR
 #include "PropertyEditorModule.h"
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#include "Misc/Paths.h"
 #include "MaterialSlotTagEntryCustomization.h"
 #include "MaterialTagUserDataCustomization.h"
+#include "MaterialTagReverseIndex.h"
+#include "MaterialTagSearchTab.h"
+#include "Framework/Docking/TabManager.h"
+#include "Framework/Application/SlateApplication.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
 #endif
 
 #define LOCTEXT_NAMESPACE "FMaterialTagPluginModule"
 
+#if WITH_EDITOR
+namespace
+{
+	void GetMaterialTagRegistryTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& OutTags)
+	{
+		const USkeletalMesh* Mesh = Cast<USkeletalMesh>(Object);
+		const TArray<UAssetUserData*>* UserDataArray = Mesh ? Mesh->GetAssetUserDataArray() : nullptr;
+		if (!UserDataArray) return;
+
+		for (const UAssetUserData* UserData : *UserDataArray)
+		{
+			if (const UMaterialTagAssetUserData* MaterialTagData = Cast<UMaterialTagAssetUserData>(UserData))
+			{
+				MaterialTagData->GetMeshAssetRegistryTags(OutTags);
+				return;
+			}
+		}
+	}
+}
+#endif
+
 void FMaterialTagPluginModule::StartupModule()
 {
+	// GetTagsForSlot is now a C++ const-ref getter; keep existing Blueprint nodes bound to its wrapper
+	TArray<FCoreRedirect> Redirects;
+	Redirects.Emplace(ECoreRedirectFlags::Type_Function,
+		TEXT("/Script/MaterialTagPlugin.MaterialTagAssetUserData.GetTagsForSlot"),
+		TEXT("/Script/MaterialTagPlugin.MaterialTagAssetUserData.K2_GetTagsForSlot"));
+	FCoreRedirects::AddRedirectList(Redirects, TEXT("MaterialTagPlugin"));
+
 #if WITH_EDITOR
 	// Register custom property type customization for FMaterialSlotTagEntry
 	FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
@@ -24,12 +63,67 @@ void FMaterialTagPluginModule::StartupModule()
 		FPresetTagDisplay::StaticStruct()->GetFName(),
 		FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FPresetTagDisplayCustomization::MakeInstance)
 	);
+
+	// The registry only asks the mesh for tags; add the user data's summaries to the mesh's entry
+	ExtraObjectTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTags.AddStatic(&GetMaterialTagRegistryTags);
+
+	// User data loaded on the async loading thread reconcile their slots once their mesh has loaded
+	EndLoadPackageHandle = FCoreUObjectDelegates::OnEndLoadPackage.AddLambda([](const FEndLoadPackageContext&)
+	{
+		UMaterialTagAssetUserData::FlushDeferredSlotReconciles();
+	});
+
+	// Tag -> mesh slot search; commandlets have no use for it
+	if (!IsRunningCommandlet())
+	{
+		FMaterialTagReverseIndex::Get().Initialize();
+		FGlobalTabmanager::Get()->RegisterNomadTabSpawner(SMaterialTagSearch::TabName, FOnSpawnTab::CreateStatic(&SMaterialTagSearch::SpawnTab))
+			.SetDisplayName(LOCTEXT("MaterialTagSearchTabTitle", "Material Tag Search"))
+			.SetTooltipText(LOCTEXT("MaterialTagSearchTabTooltip", "Find every mesh slot that uses a MaterialTag or one of its children"))
+			.SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
+	}
+
+	// Watch the plugin Config folder so regenerated presets reach open editors
+	WatchedPresetDirectory = FPaths::GetPath(FMaterialTagPresetDatabase::GetPresetIniPath());
+	FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>("DirectoryWatcher");
+	if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get())
+	{
+		DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(
+			WatchedPresetDirectory,
+			IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FMaterialTagPluginModule::OnPresetDirectoryChanged),
+			PresetDirectoryWatcherHandle
+		);
+	}
 #endif
 }
 
 void FMaterialTagPluginModule::ShutdownModule()
 {
 #if WITH_EDITOR
+	if (FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(SMaterialTagSearch::TabName);
+	}
+	FMaterialTagReverseIndex::Get().Shutdown();
+
+	UObject::FAssetRegistryTag::OnGetExtraObjectTags.Remove(ExtraObjectTagsHandle);
+	ExtraObjectTagsHandle.Reset();
+
+	FCoreUObjectDelegates::OnEndLoadPackage.Remove(EndLoadPackageHandle);
+	EndLoadPackageHandle.Reset();
+
+	if (PresetDirectoryWatcherHandle.IsValid())
+	{
+		if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>("DirectoryWatcher"))
+		{
+			if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(WatchedPresetDirectory, PresetDirectoryWatcherHandle);
+			}
+		}
+		PresetDirectoryWatcherHandle.Reset();
+	}
+
 	// Unregister custom property type customization
 	if (FModuleManager::Get().IsModuleLoaded("PropertyEditor"))
 	{
@@ -40,6 +134,26 @@ void FMaterialTagPluginModule::ShutdownModule()
 #endif
 }
 
+#if WITH_EDITOR
+void FMaterialTagPluginModule::OnPresetDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
+{
+	const FString IniFilename = FPaths::GetCleanFilename(FMaterialTagPresetDatabase::GetPresetIniPath());
+	const FString ShardDirectory = FPaths::ConvertRelativePathToFull(FMaterialTagPresetDatabase::GetPresetShardDirectory());
+
+	for (const FFileChangeData& Change : FileChanges)
+	{
+		const bool bIsPresetIni = FPaths::GetCleanFilename(Change.Filename).Equals(IniFilename, ESearchCase::IgnoreCase);
+		const bool bIsShard = FPaths::ConvertRelativePathToFull(Change.Filename).StartsWith(ShardDirectory);
+		if (bIsPresetIni || bIsShard)
+		{
+			// Re-parses on a worker; only sections whose content hash changed are reported
+			FMaterialTagPresetDatabase::Get().RequestReload();
+			return;
+		}
+	}
+}
+#endif
+
 #undef LOCTEXT_NAMESPACE
 	
 IMPLEMENT_MODULE(FMaterialTagPluginModule, MaterialTagPlugin)
@@ -0,0 +1,300 @@
+#include "MaterialTagPresetBlob.h"
+#include "MaterialTagPresetDatabase.h"
+#include "Algo/BinarySearch.h"
+
+namespace MaterialTagPresetBlob
+{
+	/** Case-sensitive string -> id map for the string table (FString's default map keys ignore case) */
+	struct FStringIdKeyFuncs : TDefaultMapKeyFuncs<FString, uint32, false>
+	{
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	class FStringTableBuilder
+	{
+	public:
+		uint32 Add(const FString& String)
+		{
+			if (const uint32* Existing = Ids.Find(String))
+			{
+				return *Existing;
+			}
+
+			const uint32 Id = Offsets.Num();
+			Offsets.Add(Bytes.Num());
+			auto Utf8 = StringCast<UTF8CHAR>(*String, String.Len());
+			Bytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+			Ids.Add(String, Id);
+			return Id;
+		}
+
+		TArray<uint32> Offsets;
+		TArray<uint8> Bytes;
+
+	private:
+		TMap<FString, uint32, FDefaultSetAllocator, FStringIdKeyFuncs> Ids;
+	};
+
+	template <typename T>
+	static uint32 AppendTable(TArray<uint8>& Blob, const TArray<T>& Table)
+	{
+		const uint32 Offset = Blob.Num();
+		Blob.Append(reinterpret_cast<const uint8*>(Table.GetData()), Table.Num() * sizeof(T));
+		return Offset;
+	}
+
+	/** Intern a UTF-8 table string without going through an FString */
+	static FName ToName(FUtf8StringView View)
+	{
+		if (View.IsEmpty())
+		{
+			return NAME_None;
+		}
+		auto Wide = StringCast<TCHAR>(View.GetData(), View.Len());
+		return FName(Wide.Length(), Wide.Get());
+	}
+
+	static bool IsTableInBounds(int64 BlobSize, uint32 Offset, uint64 Count, uint64 ElementSize)
+	{
+		return (Offset % alignof(uint32)) == 0 && Offset + Count * ElementSize <= (uint64)BlobSize;
+	}
+}
+
+void FMaterialTagPresetBlob::Compile(const TArray<TSharedPtr<const FMaterialTagPreset>>& Presets, const TArray<FString>& FoldedNames, int64 SourceTimestamp, int64 SourceSize, TArray<uint8>& OutBlob)
+{
+	using namespace MaterialTagPresetBlob;
+	check(Presets.Num() == FoldedNames.Num());
+
+	FStringTableBuilder Strings;
+	TArray<FSectionEntry> Sections;
+	TArray<uint32> Names;
+	TArray<FTagEntry> Tags;
+	TArray<uint32> Ids;
+
+	Sections.Reserve(Presets.Num());
+	Names.Reserve(Presets.Num());
+
+	for (int32 i = 0; i < Presets.Num(); i++)
+	{
+		const FMaterialTagPreset& Preset = *Presets[i];
+
+		FSectionEntry& Section = Sections.AddDefaulted_GetRef();
+		Section.FoldedName = Strings.Add(FoldedNames[i]);
+		Section.Name = Strings.Add(Preset.Name);
+		Section.ContentHash = Preset.ContentHash;
+		Names.Add(Section.Name);
+
+		Section.SlotsBegin = Ids.Num();
+		Section.NumSlots = Preset.Slots.Num();
+		for (FName Slot : Preset.Slots)
+		{
+			Ids.Add(Strings.Add(Slot.IsNone() ? FString() : Slot.ToString()));
+		}
+
+		Section.TagsBegin = Tags.Num();
+		Section.NumTags = Preset.Tags.Num();
+		for (const FMaterialTagPresetTag& Entry : Preset.Tags)
+		{
+			FTagEntry& Tag = Tags.AddDefaulted_GetRef();
+			Tag.Tag = Strings.Add(Entry.TagName.ToString());
+			Tag.SlotsBegin = Ids.Num();
+			Tag.NumSlots = Entry.Slots.Num();
+			for (FName Slot : Entry.Slots)
+			{
+				Ids.Add(Strings.Add(Slot.ToString()));
+			}
+		}
+	}
+
+	// Terminating offset so every string's length is Offsets[Id + 1] - Offsets[Id]
+	Strings.Offsets.Add(Strings.Bytes.Num());
+
+	// Sort the directory by folded name so lookups can binary-search it in place
+	auto GetFolded = [&Strings](const FSectionEntry& Entry)
+	{
+		const uint32 Begin = Strings.Offsets[Entry.FoldedName];
+		const uint32 End = Strings.Offsets[Entry.FoldedName + 1];
+		return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Strings.Bytes.GetData() + Begin), End - Begin);
+	};
+	Sections.StableSort([&GetFolded](const FSectionEntry& A, const FSectionEntry& B)
+	{
+		return GetFolded(A).Compare(GetFolded(B), ESearchCase::CaseSensitive) < 0;
+	});
+
+	OutBlob.Reset();
+	OutBlob.AddZeroed(sizeof(FHeader));
+
+	FHeader Header;
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.SourceTimestamp = SourceTimestamp;
+	Header.SourceSize = SourceSize;
+	Header.NumStrings = Strings.Offsets.Num() - 1;
+	Header.StringOffsetsOffset = AppendTable(OutBlob, Strings.Offsets);
+	Header.NumSections = Sections.Num();
+	Header.SectionsOffset = AppendTable(OutBlob, Sections);
+	Header.NamesOffset = AppendTable(OutBlob, Names);
+	Header.NumTags = Tags.Num();
+	Header.TagsOffset = AppendTable(OutBlob, Tags);
+	Header.NumIds = Ids.Num();
+	Header.IdsOffset = AppendTable(OutBlob, Ids);
+	Header.StringDataOffset = AppendTable(OutBlob, Strings.Bytes);
+
+	FMemory::Memcpy(OutBlob.GetData(), &Header, sizeof(FHeader));
+}
+
+bool FMaterialTagPresetBlob::Initialize(const uint8* InData, int64 InSize)
+{
+	using namespace MaterialTagPresetBlob;
+
+	Data = nullptr;
+	Size = 0;
+
+	if (!InData || InSize < (int64)sizeof(FHeader))
+	{
+		return false;
+	}
+
+	const FHeader& Header = *reinterpret_cast<const FHeader*>(InData);
+	if (Header.Magic != Magic || Header.Version != Version)
+	{
+		return false;
+	}
+
+	if (!IsTableInBounds(InSize, Header.StringOffsetsOffset, (uint64)Header.NumStrings + 1, sizeof(uint32))
+		|| !IsTableInBounds(InSize, Header.SectionsOffset, Header.NumSections, sizeof(FSectionEntry))
+		|| !IsTableInBounds(InSize, Header.NamesOffset, Header.NumSections, sizeof(uint32))
+		|| !IsTableInBounds(InSize, Header.TagsOffset, Header.NumTags, sizeof(FTagEntry))
+		|| !IsTableInBounds(InSize, Header.IdsOffset, Header.NumIds, sizeof(uint32)))
+	{
+		return false;
+	}
+
+	const uint32 StringDataSize = reinterpret_cast<const uint32*>(InData + Header.StringOffsetsOffset)[Header.NumStrings];
+	if ((uint64)Header.StringDataOffset + StringDataSize > (uint64)InSize)
+	{
+		return false;
+	}
+
+	Data = InData;
+	Size = InSize;
+	return true;
+}
+
+bool FMaterialTagPresetBlob::MatchesSource(int64 SourceTimestamp, int64 SourceSize) const
+{
+	return IsValid() && GetHeader().SourceTimestamp == SourceTimestamp && GetHeader().SourceSize == SourceSize;
+}
+
+FUtf8StringView FMaterialTagPresetBlob::GetString(uint32 Id) const
+{
+	const FHeader& Header = GetHeader();
+	if (Id >= Header.NumStrings)
+	{
+		return FUtf8StringView();
+	}
+
+	const uint32* Offsets = GetTable<uint32>(Header.StringOffsetsOffset);
+	const uint32 Begin = Offsets[Id];
+	const uint32 End = Offsets[Id + 1];
+	const uint32 StringDataSize = Offsets[Header.NumStrings];
+	if (Begin > End || End > StringDataSize)
+	{
+		return FUtf8StringView();
+	}
+
+	return FUtf8StringView(GetTable<UTF8CHAR>(Header.StringDataOffset) + Begin, End - Begin);
+}
+
+void FMaterialTagPresetBlob::GetNames(TArray<FString>& OutNames) const
+{
+	OutNames.Reset();
+	if (!IsValid()) return;
+
+	const FHeader& Header = GetHeader();
+	const uint32* Names = GetTable<uint32>(Header.NamesOffset);
+
+	OutNames.Reserve(Header.NumSections);
+	for (uint32 i = 0; i < Header.NumSections; i++)
+	{
+		OutNames.Emplace(GetString(Names[i]));
+	}
+}
+
+const FMaterialTagPresetBlob::FSectionEntry* FMaterialTagPresetBlob::FindSection(const FString& FoldedName) const
+{
+	if (!IsValid()) return nullptr;
+
+	const FHeader& Header = GetHeader();
+	TArrayView<const FSectionEntry> Sections(GetTable<FSectionEntry>(Header.SectionsOffset), Header.NumSections);
+
+	auto Utf8Name = StringCast<UTF8CHAR>(*FoldedName, FoldedName.Len());
+	const FUtf8StringView Key(Utf8Name.Get(), Utf8Name.Length());
+
+	const int32 Found = Algo::BinarySearchBy(Sections,
+		Key,
+		[this](const FSectionEntry& Entry) { return GetString(Entry.FoldedName); },
+		[](const FUtf8StringView& A, const FUtf8StringView& B) { return A.Compare(B, ESearchCase::CaseSensitive) < 0; });
+
+	return Found != INDEX_NONE ? &Sections[Found] : nullptr;
+}
+
+bool FMaterialTagPresetBlob::FindSectionHash(const FString& FoldedName, uint32& OutHash) const
+{
+	if (const FSectionEntry* Section = FindSection(FoldedName))
+	{
+		OutHash = Section->ContentHash;
+		return true;
+	}
+	return false;
+}
+
+TSharedPtr<const FMaterialTagPreset> FMaterialTagPresetBlob::FindPreset(const FString& FoldedName) const
+{
+	using namespace MaterialTagPresetBlob;
+
+	const FSectionEntry* Found = FindSection(FoldedName);
+	if (!Found)
+	{
+		return nullptr;
+	}
+
+	const FHeader& Header = GetHeader();
+	const FSectionEntry& Section = *Found;
+	const uint32* Ids = GetTable<uint32>(Header.IdsOffset);
+	const FTagEntry* Tags = GetTable<FTagEntry>(Header.TagsOffset);
+
+	if ((uint64)Section.SlotsBegin + Section.NumSlots > Header.NumIds
+		|| (uint64)Section.TagsBegin + Section.NumTags > Header.NumTags)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FMaterialTagPreset> Preset = MakeShared<FMaterialTagPreset>();
+	Preset->Name = FString(GetString(Section.Name));
+	Preset->ContentHash = Section.ContentHash;
+
+	Preset->Slots.Reserve(Section.NumSlots);
+	for (uint32 i = 0; i < Section.NumSlots; i++)
+	{
+		Preset->Slots.Add(ToName(GetString(Ids[Section.SlotsBegin + i])));
+	}
+
+	Preset->Tags.Reserve(Section.NumTags);
+	for (uint32 t = 0; t < Section.NumTags; t++)
+	{
+		const FTagEntry& Tag = Tags[Section.TagsBegin + t];
+		if ((uint64)Tag.SlotsBegin + Tag.NumSlots > Header.NumIds) continue;
+
+		FMaterialTagPresetTag& Entry = Preset->AddTag(ToName(GetString(Tag.Tag)));
+		Entry.Slots.Reserve(Tag.NumSlots);
+		for (uint32 i = 0; i < Tag.NumSlots; i++)
+		{
+			Entry.Slots.Add(ToName(GetString(Ids[Tag.SlotsBegin + i])));
+		}
+	}
+
+	Preset->ResolveTags();
+	return Preset;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMaterialTagPreset;
+
+/**
+ * Compiled binary form of MaterialTagPresets.ini.
+ *
+ * Layout (native endian, every offset relative to the start of the blob):
+ *   FHeader
+ *   uint32       StringOffsets[NumStrings + 1]  - byte offsets into StringData
+ *   FSectionEntry Sections[NumSections]          - sorted by folded name
+ *   uint32       Names[NumSections]             - display name string ids, INI order
+ *   FTagEntry    Tags[NumTags]                  - per-section tag lists, INI order
+ *   uint32       Ids[NumIds]                    - slot arrays and tag->slot adjacency lists
+ *   UTF8CHAR     StringData[]
+ *
+ * The reader never copies the blob; it is meant to sit on top of a memory-mapped file.
+ */
+class FMaterialTagPresetBlob
+{
+public:
+	static constexpr uint32 Magic = 0x4250544D; // 'MTPB'
+	static constexpr uint32 Version = 2;
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		int64 SourceTimestamp;
+		int64 SourceSize;
+		uint32 NumStrings;
+		uint32 StringOffsetsOffset;
+		uint32 NumSections;
+		uint32 SectionsOffset;
+		uint32 NamesOffset;
+		uint32 NumTags;
+		uint32 TagsOffset;
+		uint32 NumIds;
+		uint32 IdsOffset;
+		uint32 StringDataOffset;
+	};
+
+	struct FSectionEntry
+	{
+		uint32 FoldedName;
+		uint32 Name;
+		uint32 SlotsBegin;  // into Ids
+		uint32 NumSlots;
+		uint32 TagsBegin;   // into Tags
+		uint32 NumTags;
+		uint32 ContentHash;
+	};
+
+	struct FTagEntry
+	{
+		uint32 Tag;
+		uint32 SlotsBegin;  // into Ids
+		uint32 NumSlots;
+	};
+
+	/**
+	 * Serialize presets (in INI order) into a blob stamped with the source INI's timestamp and size.
+	 * FoldedNames must be parallel to Presets and hold each section's case-folded lookup key.
+	 */
+	static void Compile(const TArray<TSharedPtr<const FMaterialTagPreset>>& Presets, const TArray<FString>& FoldedNames, int64 SourceTimestamp, int64 SourceSize, TArray<uint8>& OutBlob);
+
+	FMaterialTagPresetBlob() = default;
+
+	/** Wrap an existing blob. Returns false (and stays invalid) if the header or any table is out of bounds. */
+	bool Initialize(const uint8* InData, int64 InSize);
+
+	bool IsValid() const { return Data != nullptr; }
+
+	/** True if the blob was compiled from a source INI with this timestamp and size */
+	bool MatchesSource(int64 SourceTimestamp, int64 SourceSize) const;
+
+	/** Section display names in INI order */
+	void GetNames(TArray<FString>& OutNames) const;
+
+	/** Binary-search the section directory by folded name and expand the hit into a preset record */
+	TSharedPtr<const FMaterialTagPreset> FindPreset(const FString& FoldedName) const;
+
+	/** Content hash of a section without expanding it */
+	bool FindSectionHash(const FString& FoldedName, uint32& OutHash) const;
+
+private:
+	/** Binary-search the section directory by folded name */
+	const FSectionEntry* FindSection(const FString& FoldedName) const;
+
+	const FHeader& GetHeader() const { return *reinterpret_cast<const FHeader*>(Data); }
+
+	template <typename T>
+	const T* GetTable(uint32 Offset) const { return reinterpret_cast<const T*>(Data + Offset); }
+
+	FUtf8StringView GetString(uint32 Id) const;
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+};
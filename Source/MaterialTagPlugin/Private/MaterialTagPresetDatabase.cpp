@@ -0,0 +1,863 @@
+#include "MaterialTagPresetDatabase.h"
+#include "MaterialTagPresetBlob.h"
+#include "MaterialTagPresetTokenizer.h"
+#include "MaterialTagPresetMatcher.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeTryLock.h"
+#include "Async/Async.h"
+
+namespace MaterialTagPresetDatabase
+{
+	/** Upper bound on a preset's SlotCount; larger values come from corrupt or hand-mangled files */
+	static constexpr int32 MaxPresetSlots = 256;
+
+	/** FCString::Atoi over a view, without allocating for short numbers */
+	static int32 ParseInt(FStringView Text)
+	{
+		TStringBuilder<32> Builder;
+		Builder << Text;
+		return FCString::Atoi(*Builder);
+	}
+}
+
+const FMaterialTagPresetTag* FMaterialTagPreset::FindTag(FName TagName) const
+{
+	return Tags.FindByPredicate([TagName](const FMaterialTagPresetTag& Entry) { return Entry.TagName == TagName; });
+}
+
+FMaterialTagPresetTag& FMaterialTagPreset::AddTag(FName TagName)
+{
+	if (FMaterialTagPresetTag* Existing = const_cast<FMaterialTagPresetTag*>(FindTag(TagName)))
+	{
+		Existing->Slots.Reset();
+		return *Existing;
+	}
+
+	FMaterialTagPresetTag& Entry = Tags.AddDefaulted_GetRef();
+	Entry.TagName = TagName;
+	return Entry;
+}
+
+void FMaterialTagPreset::ResolveTags()
+{
+	SlotToTags.Reset();
+	for (FMaterialTagPresetTag& Entry : Tags)
+	{
+		Entry.Tag = FGameplayTag::RequestGameplayTag(Entry.TagName, false);
+		if (!Entry.Tag.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("MaterialTagPresetDatabase: Preset '%s' references unknown tag '%s'"), *Name, *Entry.TagName.ToString());
+			continue;
+		}
+
+		for (FName SlotName : Entry.Slots)
+		{
+			SlotToTags.FindOrAdd(SlotName).AddUnique(Entry.Tag);
+		}
+	}
+}
+
+FMaterialTagPresetDatabase::FMaterialTagPresetDatabase() = default;
+
+FMaterialTagPresetDatabase::~FMaterialTagPresetDatabase()
+{
+	Reset();
+}
+
+FMaterialTagPresetDatabase& FMaterialTagPresetDatabase::Get()
+{
+	static FMaterialTagPresetDatabase Instance;
+	return Instance;
+}
+
+FString FMaterialTagPresetDatabase::GetPresetIniPath()
+{
+	return FPaths::ProjectPluginsDir() / TEXT("MaterialTagPlugin") / TEXT("Config") / TEXT("MaterialTagPresets.ini");
+}
+
+FString FMaterialTagPresetDatabase::GetPresetShardDirectory()
+{
+	return FPaths::ProjectPluginsDir() / TEXT("MaterialTagPlugin") / TEXT("Config") / TEXT("MaterialTagPresets");
+}
+
+FString FMaterialTagPresetDatabase::GetPresetShardManifestPath()
+{
+	return GetPresetShardDirectory() / TEXT("Manifest.ini");
+}
+
+FString FMaterialTagPresetDatabase::GetCompiledPresetPath()
+{
+	return FPaths::ProjectIntermediateDir() / TEXT("MaterialTagPlugin") / TEXT("MaterialTagPresets.bin");
+}
+
+FString FMaterialTagPresetDatabase::FoldSectionName(FStringView SectionName)
+{
+	return FString(SectionName).ToLower();
+}
+
+void FMaterialTagPresetDatabase::AppendSectionBody(FString& Out, TConstArrayView<FName> Slots, TConstArrayView<TPair<FName, TArray<FName>>> Tags)
+{
+	Out.Appendf(TEXT("SlotCount=%d\n"), Slots.Num());
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); SlotIndex++)
+	{
+		Out.Appendf(TEXT("Slot_%d=%s\n"), SlotIndex, *Slots[SlotIndex].ToString());
+	}
+
+	for (const TPair<FName, TArray<FName>>& Tag : Tags)
+	{
+		Out += Tag.Key.ToString();
+		Out += TEXT('=');
+		for (int32 Index = 0; Index < Tag.Value.Num(); Index++)
+		{
+			if (Index > 0)
+			{
+				Out += TEXT(", ");
+			}
+			Out += Tag.Value[Index].ToString();
+		}
+		Out += TEXT('\n');
+	}
+}
+
+uint32 FMaterialTagPresetDatabase::HashSection(const FString& SectionName, FStringView Body)
+{
+	return FCrc::MemCrc32(Body.GetData(), Body.Len() * sizeof(TCHAR), FCrc::StrCrc32(*SectionName));
+}
+
+bool FMaterialTagPresetDatabase::HasPresetFile()
+{
+	FScopeLock ScopeLock(&Lock);
+	RefreshIfStale();
+	return bFileExists;
+}
+
+TArray<FString> FMaterialTagPresetDatabase::GetPresetNames()
+{
+	FScopeLock ScopeLock(&Lock);
+	RefreshIfStale();
+	return SectionNames;
+}
+
+TSharedPtr<const FMaterialTagPreset> FMaterialTagPresetDatabase::FindPreset(const FString& PresetName)
+{
+	FScopeLock ScopeLock(&Lock);
+	RefreshIfStale();
+	return FindPresetLocked(FoldSectionName(PresetName));
+}
+
+TFuture<TSharedPtr<const FMaterialTagPreset>> FMaterialTagPresetDatabase::FindPresetAsync(const FString& PresetName)
+{
+	return Async(EAsyncExecution::ThreadPool, [this, PresetName]()
+	{
+		return FindPreset(PresetName);
+	});
+}
+
+TFuture<TArray<FString>> FMaterialTagPresetDatabase::GetPresetNamesAsync()
+{
+	return Async(EAsyncExecution::ThreadPool, [this]()
+	{
+		return GetPresetNames();
+	});
+}
+
+FString FMaterialTagPresetDatabase::MatchPreset(const FString& MeshName)
+{
+	FScopeLock ScopeLock(&Lock);
+	RefreshIfStale();
+	return GetMatcherLocked().Match(MeshName);
+}
+
+TFuture<FString> FMaterialTagPresetDatabase::MatchPresetAsync(const FString& MeshName)
+{
+	return Async(EAsyncExecution::ThreadPool, [this, MeshName]()
+	{
+		return MatchPreset(MeshName);
+	});
+}
+
+EMaterialTagPresetLookup FMaterialTagPresetDatabase::TryMatchPreset(const FString& MeshName, FString& OutPresetName)
+{
+	check(IsInGameThread());
+	OutPresetName.Reset();
+
+	// Building the index is a worker's job; only answer once it exists
+	FScopeTryLock ScopeLock(&Lock);
+	if (!ScopeLock.IsLocked() || !bLoaded || !Matcher.IsValid())
+	{
+		return EMaterialTagPresetLookup::Pending;
+	}
+	if (!bFileExists)
+	{
+		return EMaterialTagPresetLookup::NoPresetFile;
+	}
+
+	OutPresetName = Matcher->Match(MeshName);
+	return OutPresetName.IsEmpty() ? EMaterialTagPresetLookup::NotFound : EMaterialTagPresetLookup::Found;
+}
+
+TArray<FMaterialTagPresetCandidate> FMaterialTagPresetDatabase::RankPresets(const FString& MeshName, int32 MaxResults)
+{
+	TArray<FMaterialTagPresetCandidate> Candidates;
+	FScopeLock ScopeLock(&Lock);
+	RefreshIfStale();
+	GetMatcherLocked().Rank(MeshName, MaxResults, Candidates);
+	return Candidates;
+}
+
+TFuture<TArray<FMaterialTagPresetCandidate>> FMaterialTagPresetDatabase::RankPresetsAsync(const FString& MeshName, int32 MaxResults)
+{
+	return Async(EAsyncExecution::ThreadPool, [this, MeshName, MaxResults]()
+	{
+		return RankPresets(MeshName, MaxResults);
+	});
+}
+
+int32 FMaterialTagPresetDatabase::WarmUp()
+{
+	FScopeLock ScopeLock(&Lock);
+	RefreshIfStale();
+	GetMatcherLocked();
+	return SectionNames.Num();
+}
+
+EMaterialTagPresetLookup FMaterialTagPresetDatabase::TryRankPresets(const FString& MeshName, int32 MaxResults, TArray<FMaterialTagPresetCandidate>& OutCandidates)
+{
+	check(IsInGameThread());
+	OutCandidates.Reset();
+
+	FScopeTryLock ScopeLock(&Lock);
+	if (!ScopeLock.IsLocked() || !bLoaded || !Matcher.IsValid())
+	{
+		return EMaterialTagPresetLookup::Pending;
+	}
+	if (!bFileExists)
+	{
+		return EMaterialTagPresetLookup::NoPresetFile;
+	}
+
+	Matcher->Rank(MeshName, MaxResults, OutCandidates);
+	return OutCandidates.Num() > 0 ? EMaterialTagPresetLookup::Found : EMaterialTagPresetLookup::NotFound;
+}
+
+const FMaterialTagPresetMatcher& FMaterialTagPresetDatabase::GetMatcherLocked()
+{
+	if (!Matcher.IsValid())
+	{
+		Matcher = MakeUnique<FMaterialTagPresetMatcher>(SectionNames);
+	}
+	return *Matcher;
+}
+
+EMaterialTagPresetLookup FMaterialTagPresetDatabase::TryFindPreset(const FString& PresetName, TSharedPtr<const FMaterialTagPreset>& OutPreset)
+{
+	check(IsInGameThread());
+	OutPreset.Reset();
+
+	FString Key = FoldSectionName(PresetName);
+	{
+		// A worker holding the lock is doing disk I/O; don't wait for it
+		FScopeTryLock ScopeLock(&Lock);
+		if (ScopeLock.IsLocked() && bLoaded)
+		{
+			if (!bFileExists)
+			{
+				return EMaterialTagPresetLookup::NoPresetFile;
+			}
+			if (const TSharedPtr<const FMaterialTagPreset>* Parsed = ParsedSections.Find(Key))
+			{
+				OutPreset = *Parsed;
+				return EMaterialTagPresetLookup::Found;
+			}
+			if (MissingSections.Contains(Key))
+			{
+				return EMaterialTagPresetLookup::NotFound;
+			}
+		}
+	}
+
+	// Needs a parse or a disk read: finish on a worker and report the section through OnPresetsChanged
+	if (!PendingLookups.Contains(Key))
+	{
+		PendingLookups.Add(Key);
+		Async(EAsyncExecution::ThreadPool, [this, Key]()
+		{
+			TSet<FString> ChangedSections;
+			{
+				FScopeLock ScopeLock(&Lock);
+				RefreshIfStale();
+				FindPresetLocked(Key);
+				ChangedSections = MoveTemp(PendingChangedSections);
+				PendingChangedSections.Reset();
+			}
+			ChangedSections.Add(Key);
+			BroadcastOnGameThread(MoveTemp(ChangedSections), Key);
+		});
+	}
+	return EMaterialTagPresetLookup::Pending;
+}
+
+bool FMaterialTagPresetDatabase::TryGetPresetNames(TArray<FString>& OutNames)
+{
+	check(IsInGameThread());
+
+	bool bReady = false;
+	{
+		FScopeTryLock ScopeLock(&Lock);
+		if (ScopeLock.IsLocked() && bLoaded)
+		{
+			OutNames = SectionNames;
+			bReady = true;
+		}
+	}
+
+	// Pick up edits in the background; the next call sees them
+	StartRefresh();
+	return bReady;
+}
+
+void FMaterialTagPresetDatabase::RequestReload()
+{
+	check(IsInGameThread());
+
+	// Honoured by whichever refresh runs next, even one already in flight
+	bRestatRequested = true;
+	StartRefresh();
+}
+
+void FMaterialTagPresetDatabase::StartRefresh()
+{
+	check(IsInGameThread());
+
+	if (bReloadInFlight)
+	{
+		return;
+	}
+	bReloadInFlight = true;
+
+	Async(EAsyncExecution::ThreadPool, [this]()
+	{
+		TSet<FString> ChangedSections;
+		{
+			FScopeLock ScopeLock(&Lock);
+			RefreshIfStale();
+			ChangedSections = MoveTemp(PendingChangedSections);
+			PendingChangedSections.Reset();
+		}
+		BroadcastOnGameThread(MoveTemp(ChangedSections), FString());
+	});
+}
+
+void FMaterialTagPresetDatabase::BroadcastOnGameThread(TSet<FString>&& ChangedSections, const FString& CompletedLookup)
+{
+	AsyncTask(ENamedThreads::GameThread, [this, ChangedSections = MoveTemp(ChangedSections), CompletedLookup]()
+	{
+		if (CompletedLookup.IsEmpty())
+		{
+			bReloadInFlight = false;
+		}
+		else
+		{
+			PendingLookups.Remove(CompletedLookup);
+		}
+
+		if (ChangedSections.Num() > 0)
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("MaterialTagPresetDatabase: %d preset section(s) changed or finished loading"), ChangedSections.Num());
+			PresetsChangedEvent.Broadcast(ChangedSections);
+		}
+	});
+}
+
+TSharedPtr<const FMaterialTagPreset> FMaterialTagPresetDatabase::FindPresetLocked(const FString& Key)
+{
+	if (const TSharedPtr<const FMaterialTagPreset>* Parsed = ParsedSections.Find(Key))
+	{
+		return *Parsed;
+	}
+
+	// First lookup of this section: expand it from the blob, or parse only its slice of the file
+	TSharedPtr<const FMaterialTagPreset> Preset;
+	if (Blob.IsValid())
+	{
+		Preset = Blob->FindPreset(Key);
+	}
+	else if (const FSectionSpan* Span = FindSpan(Key))
+	{
+		Preset = ParseSection(*Span);
+	}
+
+	if (Preset.IsValid())
+	{
+		ParsedSections.Add(Key, Preset);
+	}
+	else
+	{
+		// Remembered so a reload that adds this section can report it
+		MissingSections.Add(Key);
+	}
+	return Preset;
+}
+
+bool FMaterialTagPresetDatabase::StatSource(FFileStatData& OutStat, bool& bOutShards)
+{
+	IFileManager& FileManager = IFileManager::Get();
+
+	const FFileStatData IniStat = FileManager.GetStatData(*GetPresetIniPath());
+	if (IniStat.bIsValid && !IniStat.bIsDirectory)
+	{
+		OutStat = IniStat;
+		bOutShards = false;
+		return true;
+	}
+
+	// No monolithic INI: fall back to the shard directory, stamped by its manifest if it has one
+	const FFileStatData DirectoryStat = FileManager.GetStatData(*GetPresetShardDirectory());
+	if (DirectoryStat.bIsValid && DirectoryStat.bIsDirectory)
+	{
+		const FFileStatData ManifestStat = FileManager.GetStatData(*GetPresetShardManifestPath());
+		OutStat = ManifestStat.bIsValid ? ManifestStat : DirectoryStat;
+		bOutShards = true;
+		return true;
+	}
+
+	return false;
+}
+
+bool FMaterialTagPresetDatabase::AreLoadedShardsCurrent() const
+{
+	for (const FShard& Shard : Shards)
+	{
+		if (!Shard.bLoaded) continue;
+
+		const FFileStatData Stat = IFileManager::Get().GetStatData(*Shard.Path);
+		if (!Stat.bIsValid || Stat.ModificationTime != Shard.Timestamp || Stat.FileSize != Shard.Size)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FMaterialTagPresetDatabase::RefreshIfStale()
+{
+	// Every blocking lookup comes through here; between RequestReload calls, trust the loaded stamps for a while
+	const double Now = FPlatformTime::Seconds();
+	const bool bForceRestat = bRestatRequested.exchange(false);
+	if (bLoaded && !bForceRestat && Now - LastStatTime < RestatIntervalSeconds)
+	{
+		return;
+	}
+	LastStatTime = Now;
+
+	FFileStatData Stat;
+	bool bShards = false;
+	const bool bExists = StatSource(Stat, bShards);
+
+	if (bLoaded
+		&& bExists == bFileExists
+		&& (!bExists || (bShards == bUsingShards && Stat.ModificationTime == LoadedTimestamp && Stat.FileSize == LoadedSize))
+		&& (!bUsingShards || AreLoadedShardsCurrent()))
+	{
+		return;
+	}
+
+	// Keep what was handed out before so unchanged sections survive the reload
+	TMap<FString, TSharedPtr<const FMaterialTagPreset>> PreviousSections = MoveTemp(ParsedSections);
+	TSet<FString> PreviousMissing = MoveTemp(MissingSections);
+	TUniquePtr<FMaterialTagPresetMatcher> PreviousMatcher = MoveTemp(Matcher);
+	Reset();
+
+	if (bExists)
+	{
+		bFileExists = true;
+		bUsingShards = bShards;
+		LoadedTimestamp = Stat.ModificationTime;
+		LoadedSize = Stat.FileSize;
+
+		if (bUsingShards)
+		{
+			BuildShardManifest();
+		}
+		// Fall back to the text INI whenever the blob is missing or was compiled from an older INI
+		else if (!OpenCompiledBlob())
+		{
+			FFileHelper::LoadFileToString(FileText, *GetPresetIniPath());
+			IndexText(INDEX_NONE, true);
+		}
+	}
+
+	for (TPair<FString, TSharedPtr<const FMaterialTagPreset>>& Pair : PreviousSections)
+	{
+		uint32 NewHash = 0;
+		if (FindSectionHash(Pair.Key, NewHash) && NewHash == Pair.Value->ContentHash)
+		{
+			ParsedSections.Add(Pair.Key, MoveTemp(Pair.Value));
+		}
+		else
+		{
+			PendingChangedSections.Add(Pair.Key);
+		}
+	}
+
+	for (const FString& Key : PreviousMissing)
+	{
+		uint32 NewHash = 0;
+		if (FindSectionHash(Key, NewHash))
+		{
+			PendingChangedSections.Add(Key);
+		}
+		else
+		{
+			MissingSections.Add(Key);
+		}
+	}
+
+	// Edits that keep the section list as-is don't invalidate the match index
+	if (PreviousMatcher.IsValid() && PreviousMatcher->IsBuiltFrom(SectionNames))
+	{
+		Matcher = MoveTemp(PreviousMatcher);
+	}
+
+	// Shards are loaded piecemeal, so only the monolithic INI is compiled
+	if (bFileExists && !bUsingShards && !Blob.IsValid())
+	{
+		StartCompileBlob();
+	}
+
+	bLoaded = true;
+}
+
+bool FMaterialTagPresetDatabase::FindSectionHash(const FString& FoldedName, uint32& OutHash)
+{
+	if (Blob.IsValid())
+	{
+		return Blob->FindSectionHash(FoldedName, OutHash);
+	}
+
+	if (const FSectionSpan* Span = FindSpan(FoldedName))
+	{
+		OutHash = Span->ContentHash;
+		return true;
+	}
+	return false;
+}
+
+const FMaterialTagPresetDatabase::FSectionSpan* FMaterialTagPresetDatabase::FindSpan(const FString& FoldedName)
+{
+	if (const FSectionSpan* Span = SectionIndex.Find(FoldedName))
+	{
+		return Span;
+	}
+
+	// Shard bodies are only read the first time one of their presets is needed
+	if (const int32* ShardIndex = ShardManifest.Find(FoldedName))
+	{
+		if (!Shards[*ShardIndex].bLoaded)
+		{
+			LoadShard(*ShardIndex, false);
+			return SectionIndex.Find(FoldedName);
+		}
+	}
+	return nullptr;
+}
+
+void FMaterialTagPresetDatabase::BuildShardManifest()
+{
+	const FString Directory = GetPresetShardDirectory();
+	const FString ManifestPath = GetPresetShardManifestPath();
+
+	TMap<FString, int32> ShardsByFile;
+	auto AddShard = [this, &Directory, &ShardsByFile](const FString& Filename) -> int32
+	{
+		if (const int32* Existing = ShardsByFile.Find(Filename))
+		{
+			return *Existing;
+		}
+		const int32 Index = Shards.AddDefaulted();
+		Shards[Index].Path = Directory / Filename;
+		ShardsByFile.Add(Filename, Index);
+		return Index;
+	};
+
+	FString ManifestText;
+	if (FFileHelper::LoadFileToString(ManifestText, *ManifestPath))
+	{
+		// SectionName=ShardFile.ini, one line per preset
+		FMaterialTagPresetTokenizer Tokenizer(ManifestText);
+		FMaterialTagPresetTokenizer::FToken Token;
+		while (Tokenizer.Next(Token))
+		{
+			if (Token.Type != FMaterialTagPresetTokenizer::ETokenType::KeyValue || Token.Key.IsEmpty() || Token.Value.IsEmpty()) continue;
+
+			FString Key = FoldSectionName(Token.Key);
+			if (ShardManifest.Contains(Key)) continue;
+
+			SectionNames.Emplace(Token.Key);
+			ShardManifest.Add(MoveTemp(Key), AddShard(FString(Token.Value)));
+		}
+		return;
+	}
+
+	// No manifest: index every shard's headers now, in filename order
+	UE_LOG(LogTemp, Log, TEXT("MaterialTagPresetDatabase: No %s, indexing all shards in %s"), *FPaths::GetCleanFilename(ManifestPath), *Directory);
+
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *(Directory / TEXT("*.ini")), true, false);
+	Files.Sort();
+
+	for (const FString& Filename : Files)
+	{
+		if (Filename.Equals(FPaths::GetCleanFilename(ManifestPath), ESearchCase::IgnoreCase)) continue;
+		LoadShard(AddShard(Filename), true);
+	}
+}
+
+void FMaterialTagPresetDatabase::LoadShard(int32 ShardIndex, bool bRecordNames)
+{
+	FShard& Shard = Shards[ShardIndex];
+	Shard.bLoaded = true;
+
+	const FFileStatData Stat = IFileManager::Get().GetStatData(*Shard.Path);
+	Shard.Timestamp = Stat.ModificationTime;
+	Shard.Size = Stat.bIsValid ? Stat.FileSize : INDEX_NONE;
+
+	if (!FFileHelper::LoadFileToString(Shard.Text, *Shard.Path))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MaterialTagPresetDatabase: Could not read preset shard %s"), *Shard.Path);
+		return;
+	}
+
+	IndexText(ShardIndex, bRecordNames);
+}
+
+void FMaterialTagPresetDatabase::Reset()
+{
+	bFileExists = false;
+	LoadedTimestamp = FDateTime::MinValue();
+	LoadedSize = INDEX_NONE;
+
+	// Region must go before the file handle it was mapped from
+	Blob.Reset();
+	MappedRegion.Reset();
+	MappedFile.Reset();
+
+	bUsingShards = false;
+	Shards.Empty();
+	ShardManifest.Empty();
+
+	FileText.Empty();
+	SectionNames.Empty();
+	Matcher.Reset();
+	SectionIndex.Empty();
+	ParsedSections.Empty();
+	MissingSections.Empty();
+}
+
+bool FMaterialTagPresetDatabase::OpenCompiledBlob()
+{
+	const FString BlobPath = GetCompiledPresetPath();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*BlobPath))
+	{
+		return false;
+	}
+
+	TUniquePtr<IMappedFileHandle> File(PlatformFile.OpenMapped(*BlobPath));
+	if (!File.IsValid() || File->GetFileSize() <= 0)
+	{
+		return false;
+	}
+
+	TUniquePtr<IMappedFileRegion> Region(File->MapRegion(0, File->GetFileSize()));
+	if (!Region.IsValid())
+	{
+		return false;
+	}
+
+	TUniquePtr<FMaterialTagPresetBlob> NewBlob = MakeUnique<FMaterialTagPresetBlob>();
+	if (!NewBlob->Initialize(Region->GetMappedPtr(), Region->GetMappedSize())
+		|| !NewBlob->MatchesSource(LoadedTimestamp.GetTicks(), LoadedSize))
+	{
+		return false;
+	}
+
+	NewBlob->GetNames(SectionNames);
+	Blob = MoveTemp(NewBlob);
+	MappedRegion = MoveTemp(Region);
+	MappedFile = MoveTemp(File);
+	return true;
+}
+
+void FMaterialTagPresetDatabase::StartCompileBlob()
+{
+	if (CompileTask.IsValid() && !CompileTask.IsReady())
+	{
+		return;
+	}
+
+	// Everything the worker needs is copied, so later reloads can't pull the text out from under it
+	struct FSectionToCompile
+	{
+		FString FoldedName;
+		TSharedPtr<const FMaterialTagPreset> Preset;
+		FSectionSpan Span;
+	};
+	TArray<FSectionToCompile> Sections;
+	Sections.Reserve(SectionNames.Num());
+	for (const FString& SectionName : SectionNames)
+	{
+		FString Key = FoldSectionName(SectionName);
+		const FSectionSpan& Span = SectionIndex.FindChecked(Key);
+		TSharedPtr<const FMaterialTagPreset> Preset = ParsedSections.FindRef(Key);
+		Sections.Add(FSectionToCompile{ MoveTemp(Key), MoveTemp(Preset), Span });
+	}
+
+	CompileTask = Async(EAsyncExecution::ThreadPool,
+		[Text = FileText, Sections = MoveTemp(Sections), SourceTimestamp = LoadedTimestamp.GetTicks(), SourceSize = LoadedSize]() mutable
+	{
+		TArray<TSharedPtr<const FMaterialTagPreset>> Presets;
+		TArray<FString> FoldedNames;
+		Presets.Reserve(Sections.Num());
+		FoldedNames.Reserve(Sections.Num());
+		for (FSectionToCompile& Section : Sections)
+		{
+			// The blob keeps tag names only, so unparsed sections skip resolving their tags
+			if (!Section.Preset.IsValid())
+			{
+				const FSectionSpan& Span = Section.Span;
+				Section.Preset = ParseSectionBody(Span.Name, Span.ContentHash, FStringView(Text).Mid(Span.Begin, Span.End - Span.Begin));
+			}
+			Presets.Add(MoveTemp(Section.Preset));
+			FoldedNames.Add(MoveTemp(Section.FoldedName));
+		}
+
+		TArray<uint8> BlobData;
+		FMaterialTagPresetBlob::Compile(Presets, FoldedNames, SourceTimestamp, SourceSize, BlobData);
+
+		// Written aside and moved into place, so a load never maps a half-written blob
+		const FString BlobPath = GetCompiledPresetPath();
+		const FString TempPath = BlobPath + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(BlobData, *TempPath) || !IFileManager::Get().Move(*BlobPath, *TempPath, true, true))
+		{
+			IFileManager::Get().Delete(*TempPath);
+			UE_LOG(LogTemp, Warning, TEXT("MaterialTagPresetDatabase: Could not write compiled presets to %s"), *BlobPath);
+		}
+	});
+}
+
+const FString& FMaterialTagPresetDatabase::GetSpanText(const FSectionSpan& Span) const
+{
+	return Span.ShardIndex == INDEX_NONE ? FileText : Shards[Span.ShardIndex].Text;
+}
+
+void FMaterialTagPresetDatabase::IndexText(int32 ShardIndex, bool bRecordNames)
+{
+	const FString& Text = ShardIndex == INDEX_NONE ? FileText : Shards[ShardIndex].Text;
+
+	// Single pass over the headers: record where each section's body starts and ends
+	FMaterialTagPresetTokenizer Tokenizer(Text);
+	FMaterialTagPresetTokenizer::FToken Token;
+	FSectionSpan* Open = nullptr;
+
+	// Hash name + body so a reload can tell which sections were actually edited
+	auto CloseSpan = [&Text](FSectionSpan& Span, int32 End)
+	{
+		Span.End = End;
+		Span.ContentHash = HashSection(Span.Name, FStringView(Text).Mid(Span.Begin, Span.End - Span.Begin));
+	};
+
+	while (Tokenizer.Next(Token))
+	{
+		if (Token.Type != FMaterialTagPresetTokenizer::ETokenType::Section) continue;
+
+		if (Open)
+		{
+			CloseSpan(*Open, Token.LineBegin);
+			Open = nullptr;
+		}
+
+		if (Token.Name.IsEmpty()) continue;
+
+		// Duplicate sections are ignored; the first one wins
+		FString Key = FoldSectionName(Token.Name);
+		if (SectionIndex.Contains(Key)) continue;
+
+		if (bRecordNames)
+		{
+			SectionNames.Emplace(Token.Name);
+		}
+		if (ShardIndex != INDEX_NONE && !ShardManifest.Contains(Key))
+		{
+			ShardManifest.Add(Key, ShardIndex);
+		}
+		Open = &SectionIndex.Add(MoveTemp(Key), FSectionSpan{ FString(Token.Name), ShardIndex, Token.LineEnd, Text.Len(), 0 });
+	}
+
+	if (Open)
+	{
+		CloseSpan(*Open, Text.Len());
+	}
+}
+
+TSharedPtr<const FMaterialTagPreset> FMaterialTagPresetDatabase::ParseSection(const FSectionSpan& Span) const
+{
+	TSharedRef<FMaterialTagPreset> Preset = ParseSectionBody(Span.Name, Span.ContentHash, FStringView(GetSpanText(Span)).Mid(Span.Begin, Span.End - Span.Begin));
+	Preset->ResolveTags();
+	return Preset;
+}
+
+TSharedRef<FMaterialTagPreset> FMaterialTagPresetDatabase::ParseSectionBody(const FString& Name, uint32 ContentHash, FStringView Body)
+{
+	using namespace MaterialTagPresetDatabase;
+
+	TSharedRef<FMaterialTagPreset> Preset = MakeShared<FMaterialTagPreset>();
+	Preset->Name = Name;
+	Preset->ContentHash = ContentHash;
+
+	// Only the strings kept in the record are allocated; lines, keys and values stay views into the loaded text
+	FMaterialTagPresetTokenizer Tokenizer(Body);
+	FMaterialTagPresetTokenizer::FToken Token;
+
+	while (Tokenizer.Next(Token))
+	{
+		if (Token.Type != FMaterialTagPresetTokenizer::ETokenType::KeyValue) continue;
+
+		if (Token.Key.Equals(TEXT("SlotCount"), ESearchCase::IgnoreCase))
+		{
+			// Sections are parsed on workers, so a bad count must not assert or allocate without bound
+			const int32 SlotCount = ParseInt(Token.Value);
+			if (SlotCount < 0 || SlotCount > MaxPresetSlots)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("MaterialTagPresetDatabase: Preset '%s' has invalid SlotCount %d (expected 0-%d), ignoring it"),
+					*Name, SlotCount, MaxPresetSlots);
+				continue;
+			}
+			Preset->Slots.SetNum(SlotCount);
+		}
+		else if (Token.Key.StartsWith(TEXT("Slot_"), ESearchCase::IgnoreCase))
+		{
+			int32 Idx = ParseInt(Token.Key.RightChop(5));
+			if (Preset->Slots.IsValidIndex(Idx))
+			{
+				Preset->Slots[Idx] = FName(Token.Value);
+			}
+		}
+		else if (!Token.Key.StartsWith(TEXT("SlotCount"), ESearchCase::IgnoreCase))
+		{
+			// Tag=Slot1, Slot2
+			TArray<FName>& Slots = Preset->AddTag(FName(Token.Key)).Slots;
+			FMaterialTagPresetTokenizer::ForEachListItem(Token.Value, [&Slots](FStringView Item)
+			{
+				Slots.Emplace(Item);
+			});
+		}
+	}
+
+	return Preset;
+}
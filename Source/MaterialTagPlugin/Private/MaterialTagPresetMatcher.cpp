@@ -0,0 +1,472 @@
+#include "MaterialTagPresetMatcher.h"
+#include "Algo/Unique.h"
+
+namespace MaterialTagPresetMatcher
+{
+	/** Length of a character ID as used in mesh and preset names (e.g. 1014001) */
+	static constexpr int32 CharacterIdLen = 7;
+
+	/** ASCII digits only, like the preset and mesh naming scheme */
+	static bool IsIdDigit(TCHAR Char)
+	{
+		return Char >= TEXT('0') && Char <= TEXT('9');
+	}
+
+	static uint64 PackTrigram(TCHAR A, TCHAR B, TCHAR C)
+	{
+		return ((uint64)(uint32)A << 42) | ((uint64)(uint32)B << 21) | (uint64)(uint32)C;
+	}
+}
+
+int32 FMaterialTagPresetMatcher::FState::Find(TCHAR Char) const
+{
+	for (const TPair<TCHAR, int32>& Edge : Next)
+	{
+		if (Edge.Key == Char)
+		{
+			return Edge.Value;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void FMaterialTagPresetMatcher::FState::Set(TCHAR Char, int32 State)
+{
+	for (TPair<TCHAR, int32>& Edge : Next)
+	{
+		if (Edge.Key == Char)
+		{
+			Edge.Value = State;
+			return;
+		}
+	}
+	Next.Emplace(Char, State);
+}
+
+FMaterialTagPresetMatcher::FMaterialTagPresetMatcher(const TArray<FString>& InNames)
+	: Names(InNames)
+{
+	TArray<FString> FoldedNames;
+	FoldedNames.Reserve(Names.Num());
+
+	for (int32 i = 0; i < Names.Num(); i++)
+	{
+		FoldedNames.Add(Fold(Names[i]));
+		if (!Names[i].IsEmpty() && !ExactIndex.Contains(Names[i]))
+		{
+			ExactIndex.Add(Names[i], i);
+		}
+	}
+
+	BuildAhoCorasick(FoldedNames);
+	BuildSuffixAutomaton(FoldedNames);
+	BuildCharacterIdIndex();
+	BuildTrigramIndex(FoldedNames);
+}
+
+bool FMaterialTagPresetMatcher::IsBuiltFrom(const TArray<FString>& InNames) const
+{
+	if (InNames.Num() != Names.Num())
+	{
+		return false;
+	}
+
+	for (int32 i = 0; i < Names.Num(); i++)
+	{
+		if (!Names[i].Equals(InNames[i], ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+FString FMaterialTagPresetMatcher::Fold(const FString& Name)
+{
+	FString Folded = Name;
+	for (TCHAR& Char : Folded.GetCharArray())
+	{
+		Char = FChar::ToUpper(Char);
+	}
+	return Folded;
+}
+
+void FMaterialTagPresetMatcher::BuildAhoCorasick(const TArray<FString>& FoldedNames)
+{
+	AhoCorasick.Reset();
+	AhoCorasick.AddDefaulted();
+	AhoCorasick[0].Link = 0;
+
+	// Trie of every name; the node a name ends at remembers the earliest name ending there
+	for (int32 i = 0; i < FoldedNames.Num(); i++)
+	{
+		if (FoldedNames[i].IsEmpty()) continue;
+
+		int32 Node = 0;
+		for (TCHAR Char : FoldedNames[i])
+		{
+			int32 Child = AhoCorasick[Node].Find(Char);
+			if (Child == INDEX_NONE)
+			{
+				Child = AhoCorasick.AddDefaulted();
+				AhoCorasick[Child].Len = AhoCorasick[Node].Len + 1;
+				AhoCorasick[Node].Set(Char, Child);
+			}
+			Node = Child;
+		}
+		AhoCorasick[Node].MinIndex = FMath::Min(AhoCorasick[Node].MinIndex, i);
+	}
+
+	// Failure links in breadth-first order, folding each node's dictionary suffixes into its MinIndex
+	TArray<int32> Queue;
+	Queue.Reserve(AhoCorasick.Num());
+	for (const TPair<TCHAR, int32>& Edge : AhoCorasick[0].Next)
+	{
+		AhoCorasick[Edge.Value].Link = 0;
+		Queue.Add(Edge.Value);
+	}
+
+	for (int32 Head = 0; Head < Queue.Num(); Head++)
+	{
+		const int32 Node = Queue[Head];
+		for (const TPair<TCHAR, int32>& Edge : AhoCorasick[Node].Next)
+		{
+			int32 Fallback = AhoCorasick[Node].Link;
+			while (Fallback != 0 && AhoCorasick[Fallback].Find(Edge.Key) == INDEX_NONE)
+			{
+				Fallback = AhoCorasick[Fallback].Link;
+			}
+			const int32 Target = AhoCorasick[Fallback].Find(Edge.Key);
+
+			FState& Child = AhoCorasick[Edge.Value];
+			Child.Link = Target != INDEX_NONE ? Target : 0;
+			Child.MinIndex = FMath::Min(Child.MinIndex, AhoCorasick[Child.Link].MinIndex);
+			Queue.Add(Edge.Value);
+		}
+	}
+}
+
+void FMaterialTagPresetMatcher::BuildSuffixAutomaton(const TArray<FString>& FoldedNames)
+{
+	SuffixAutomaton.Reset();
+	SuffixAutomaton.AddDefaulted();
+
+	TArray<FState>& States = SuffixAutomaton;
+	auto Clone = [&States](int32 Source, int32 Len)
+	{
+		FState Copy = States[Source];
+		Copy.Len = Len;
+		Copy.MinIndex = MAX_int32;
+		return States.Add(MoveTemp(Copy));
+	};
+
+	// Generalized online construction: every name restarts from the root and reuses existing states
+	auto Extend = [&States, &Clone](int32 Last, TCHAR Char)
+	{
+		const int32 Existing = States[Last].Find(Char);
+		if (Existing != INDEX_NONE)
+		{
+			if (States[Existing].Len == States[Last].Len + 1)
+			{
+				return Existing;
+			}
+
+			const int32 Split = Clone(Existing, States[Last].Len + 1);
+			States[Existing].Link = Split;
+			for (int32 P = Last; P != INDEX_NONE && States[P].Find(Char) == Existing; P = States[P].Link)
+			{
+				States[P].Set(Char, Split);
+			}
+			return Split;
+		}
+
+		const int32 Cur = States.AddDefaulted();
+		States[Cur].Len = States[Last].Len + 1;
+
+		int32 P = Last;
+		while (P != INDEX_NONE && States[P].Find(Char) == INDEX_NONE)
+		{
+			States[P].Set(Char, Cur);
+			P = States[P].Link;
+		}
+
+		if (P == INDEX_NONE)
+		{
+			States[Cur].Link = 0;
+			return Cur;
+		}
+
+		const int32 Q = States[P].Find(Char);
+		if (States[P].Len + 1 == States[Q].Len)
+		{
+			States[Cur].Link = Q;
+			return Cur;
+		}
+
+		const int32 Split = Clone(Q, States[P].Len + 1);
+		for (; P != INDEX_NONE && States[P].Find(Char) == Q; P = States[P].Link)
+		{
+			States[P].Set(Char, Split);
+		}
+		States[Q].Link = Split;
+		States[Cur].Link = Split;
+		return Cur;
+	};
+
+	// Mark the state of every prefix with the name it came from...
+	int32 MaxLen = 0;
+	for (int32 i = 0; i < FoldedNames.Num(); i++)
+	{
+		if (FoldedNames[i].IsEmpty()) continue;
+
+		int32 Last = 0;
+		for (TCHAR Char : FoldedNames[i])
+		{
+			Last = Extend(Last, Char);
+			States[Last].MinIndex = FMath::Min(States[Last].MinIndex, i);
+		}
+		MaxLen = FMath::Max(MaxLen, FoldedNames[i].Len());
+	}
+
+	// ...then push the earliest name up the suffix-link tree, longest states first, so every state
+	// knows the earliest name containing its substrings
+	TArray<int32> CountByLen;
+	CountByLen.SetNumZeroed(MaxLen + 2);
+	for (const FState& State : States)
+	{
+		CountByLen[State.Len + 1]++;
+	}
+	for (int32 Len = 1; Len < CountByLen.Num(); Len++)
+	{
+		CountByLen[Len] += CountByLen[Len - 1];
+	}
+	TArray<int32> ByLen;
+	ByLen.SetNumUninitialized(States.Num());
+	for (int32 s = 0; s < States.Num(); s++)
+	{
+		ByLen[CountByLen[States[s].Len]++] = s;
+	}
+
+	for (int32 i = ByLen.Num() - 1; i > 0; i--)
+	{
+		const FState& State = States[ByLen[i]];
+		if (State.Link != INDEX_NONE)
+		{
+			States[State.Link].MinIndex = FMath::Min(States[State.Link].MinIndex, State.MinIndex);
+		}
+	}
+}
+
+void FMaterialTagPresetMatcher::BuildCharacterIdIndex()
+{
+	using namespace MaterialTagPresetMatcher;
+
+	CharacterIdIndex.Reset();
+	for (int32 i = 0; i < Names.Num(); i++)
+	{
+		const FString& Name = Names[i];
+		int32 RunLen = 0;
+		for (int32 c = 0; c < Name.Len(); c++)
+		{
+			RunLen = IsIdDigit(Name[c]) ? RunLen + 1 : 0;
+			if (RunLen >= CharacterIdLen)
+			{
+				FString Id = Name.Mid(c + 1 - CharacterIdLen, CharacterIdLen);
+				if (!CharacterIdIndex.Contains(Id))
+				{
+					CharacterIdIndex.Add(MoveTemp(Id), i);
+				}
+			}
+		}
+	}
+}
+
+void FMaterialTagPresetMatcher::GetTrigrams(const FString& Folded, TArray<uint64>& OutTrigrams)
+{
+	using namespace MaterialTagPresetMatcher;
+
+	OutTrigrams.Reset();
+	if (Folded.IsEmpty()) return;
+
+	const FString Padded = TEXT("  ") + Folded + TEXT(" ");
+	OutTrigrams.Reserve(Padded.Len() - 2);
+	for (int32 c = 0; c + 2 < Padded.Len(); c++)
+	{
+		OutTrigrams.Add(PackTrigram(Padded[c], Padded[c + 1], Padded[c + 2]));
+	}
+
+	OutTrigrams.Sort();
+	OutTrigrams.SetNum(Algo::Unique(OutTrigrams));
+}
+
+void FMaterialTagPresetMatcher::BuildTrigramIndex(const TArray<FString>& FoldedNames)
+{
+	TrigramPostings.Reset();
+	TrigramCounts.SetNumZeroed(FoldedNames.Num());
+
+	TArray<uint64> Trigrams;
+	for (int32 i = 0; i < FoldedNames.Num(); i++)
+	{
+		GetTrigrams(FoldedNames[i], Trigrams);
+		TrigramCounts[i] = Trigrams.Num();
+		for (uint64 Trigram : Trigrams)
+		{
+			TrigramPostings.FindOrAdd(Trigram).Add(i);
+		}
+	}
+}
+
+void FMaterialTagPresetMatcher::Rank(const FString& MeshName, int32 MaxResults, TArray<FMaterialTagPresetCandidate>& OutCandidates) const
+{
+	OutCandidates.Reset();
+	if (MaxResults <= 0 || Names.Num() == 0) return;
+
+	TArray<uint64> QueryTrigrams;
+	GetTrigrams(Fold(MeshName), QueryTrigrams);
+	if (QueryTrigrams.Num() == 0) return;
+
+	// Count shared trigrams through the postings; only presets that share one are ever touched
+	TArray<int32> Shared;
+	Shared.SetNumZeroed(Names.Num());
+	TArray<int32> Touched;
+	for (uint64 Trigram : QueryTrigrams)
+	{
+		if (const TArray<int32>* Postings = TrigramPostings.Find(Trigram))
+		{
+			for (int32 Index : *Postings)
+			{
+				if (Shared[Index]++ == 0)
+				{
+					Touched.Add(Index);
+				}
+			}
+		}
+	}
+
+	const int32* Exact = ExactIndex.Find(MeshName);
+	auto Score = [&](int32 Index)
+	{
+		if (Exact && *Exact == Index)
+		{
+			return 1.0f;
+		}
+		return 2.0f * Shared[Index] / (float)(QueryTrigrams.Num() + TrigramCounts[Index]);
+	};
+
+	// Keep the best MaxResults in a heap with the worst on top, so the full candidate list is never sorted
+	struct FScored
+	{
+		float Score;
+		int32 Index;
+	};
+	auto IsBetter = [](const FScored& A, const FScored& B)
+	{
+		return A.Score > B.Score || (A.Score == B.Score && A.Index < B.Index);
+	};
+	auto IsWorse = [&IsBetter](const FScored& A, const FScored& B)
+	{
+		return IsBetter(B, A);
+	};
+
+	TArray<FScored> Best;
+	Best.Reserve(MaxResults + 1);
+	for (int32 Index : Touched)
+	{
+		const FScored Candidate{Score(Index), Index};
+		if (Best.Num() < MaxResults)
+		{
+			Best.HeapPush(Candidate, IsWorse);
+		}
+		else if (IsBetter(Candidate, Best.HeapTop()))
+		{
+			Best.HeapPopDiscard(IsWorse, false);
+			Best.HeapPush(Candidate, IsWorse);
+		}
+	}
+
+	Best.Sort(IsBetter);
+	OutCandidates.Reserve(Best.Num());
+	for (const FScored& Scored : Best)
+	{
+		FMaterialTagPresetCandidate& Candidate = OutCandidates.AddDefaulted_GetRef();
+		Candidate.Name = Names[Scored.Index];
+		Candidate.Score = Scored.Score;
+	}
+}
+
+int32 FMaterialTagPresetMatcher::FindPresetInMeshName(const FString& Folded) const
+{
+	int32 Best = MAX_int32;
+	int32 Node = 0;
+	for (TCHAR Char : Folded)
+	{
+		int32 Next = AhoCorasick[Node].Find(Char);
+		while (Next == INDEX_NONE && Node != 0)
+		{
+			Node = AhoCorasick[Node].Link;
+			Next = AhoCorasick[Node].Find(Char);
+		}
+		Node = Next != INDEX_NONE ? Next : 0;
+		Best = FMath::Min(Best, AhoCorasick[Node].MinIndex);
+	}
+	return Best;
+}
+
+int32 FMaterialTagPresetMatcher::FindMeshNameInPreset(const FString& Folded) const
+{
+	int32 State = 0;
+	for (TCHAR Char : Folded)
+	{
+		State = SuffixAutomaton[State].Find(Char);
+		if (State == INDEX_NONE)
+		{
+			return MAX_int32;
+		}
+	}
+	return SuffixAutomaton[State].MinIndex;
+}
+
+FStringView FMaterialTagPresetMatcher::FindCharacterId(const FString& Name)
+{
+	using namespace MaterialTagPresetMatcher;
+
+	int32 RunLen = 0;
+	for (int32 c = 0; c < Name.Len(); c++)
+	{
+		RunLen = IsIdDigit(Name[c]) ? RunLen + 1 : 0;
+		if (RunLen == CharacterIdLen)
+		{
+			return FStringView(Name).Mid(c + 1 - CharacterIdLen, CharacterIdLen);
+		}
+	}
+	return FStringView();
+}
+
+FString FMaterialTagPresetMatcher::Match(const FString& MeshName) const
+{
+	// Try exact match first
+	if (const int32* Exact = ExactIndex.Find(MeshName))
+	{
+		return Names[*Exact];
+	}
+
+	// Try substring match (mesh name contains preset name or vice versa)
+	const FString Folded = Fold(MeshName);
+	const int32 Substring = FMath::Min(FindPresetInMeshName(Folded), FindMeshNameInPreset(Folded));
+	if (Substring != MAX_int32)
+	{
+		return Names[Substring];
+	}
+
+	// Try matching by character ID (e.g. "1014001" in both names)
+	const FStringView CharId = FindCharacterId(MeshName);
+	if (!CharId.IsEmpty())
+	{
+		if (const int32* ById = CharacterIdIndex.Find(FString(CharId)))
+		{
+			return Names[*ById];
+		}
+	}
+
+	return FString();
+}
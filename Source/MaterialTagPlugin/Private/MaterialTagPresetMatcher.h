@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MaterialTagPresetDatabase.h"
+
+/**
+ * Prebuilt index for picking the preset that matches a mesh name.
+ *
+ * Gives the same answer as checking the preset names in order with three rules, without scanning them:
+ *   1. the name equals the mesh name, ignoring case                 -> exact-match hash map
+ *   2. either name contains the other, ignoring case                -> Aho-Corasick automaton over the preset names
+ *                                                                      (preset inside mesh name) and a generalized
+ *                                                                      suffix automaton (mesh name inside preset)
+ *   3. the name contains the mesh name's first 7-digit character ID -> character ID inverted index
+ * Within a rule the earliest preset wins; a later rule is only tried if the earlier ones found nothing.
+ *
+ * Rank scores presets instead, by the Dice coefficient of their case-folded trigram sets, through a
+ * trigram -> preset inverted index, so only presets sharing at least one trigram with the mesh name are touched.
+ *
+ * Immutable once built, so it can be shared across threads.
+ */
+class FMaterialTagPresetMatcher
+{
+public:
+	explicit FMaterialTagPresetMatcher(const TArray<FString>& InNames);
+
+	/** Best preset name for the mesh, or an empty string if no rule matches */
+	FString Match(const FString& MeshName) const;
+
+	/** Best MaxResults presets by trigram similarity, best first; ties go to the earlier preset */
+	void Rank(const FString& MeshName, int32 MaxResults, TArray<FMaterialTagPresetCandidate>& OutCandidates) const;
+
+	/** True if the matcher was built from exactly these names, in this order */
+	bool IsBuiltFrom(const TArray<FString>& InNames) const;
+
+private:
+	/** Sparse per-state transition list; fan-out is small everywhere except the root */
+	struct FState
+	{
+		TArray<TPair<TCHAR, int32>, TInlineAllocator<2>> Next;
+		int32 Link = INDEX_NONE;
+		int32 Len = 0;
+		/** Earliest preset index that ends at (Aho-Corasick) or contains (suffix automaton) this state */
+		int32 MinIndex = MAX_int32;
+
+		int32 Find(TCHAR Char) const;
+		void Set(TCHAR Char, int32 State);
+	};
+
+	/** Case folding that agrees with FString::Contains(IgnoreCase) */
+	static FString Fold(const FString& Name);
+
+	void BuildAhoCorasick(const TArray<FString>& FoldedNames);
+	void BuildSuffixAutomaton(const TArray<FString>& FoldedNames);
+	void BuildCharacterIdIndex();
+	void BuildTrigramIndex(const TArray<FString>& FoldedNames);
+
+	/** Distinct trigrams of a folded name padded like pg_trgm ("  NAME "), sorted */
+	static void GetTrigrams(const FString& Folded, TArray<uint64>& OutTrigrams);
+
+	/** Earliest preset whose name occurs inside Folded */
+	int32 FindPresetInMeshName(const FString& Folded) const;
+
+	/** Earliest preset whose name contains Folded */
+	int32 FindMeshNameInPreset(const FString& Folded) const;
+
+	/** First run of 7 digits in the name, or empty */
+	static FStringView FindCharacterId(const FString& Name);
+
+	TArray<FString> Names;
+
+	/** Name -> first index; FString map keys compare like FString::Equals(IgnoreCase) */
+	TMap<FString, int32> ExactIndex;
+
+	/** Every 7-digit window of every name -> first index */
+	TMap<FString, int32> CharacterIdIndex;
+
+	/** Trigram -> indices of the presets containing it, ascending */
+	TMap<uint64, TArray<int32>> TrigramPostings;
+
+	/** Distinct trigram count per preset */
+	TArray<int32> TrigramCounts;
+
+	TArray<FState> AhoCorasick;
+	TArray<FState> SuffixAutomaton;
+};
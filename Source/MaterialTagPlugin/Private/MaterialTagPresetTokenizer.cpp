@@ -0,0 +1,47 @@
+#include "MaterialTagPresetTokenizer.h"
+
+bool FMaterialTagPresetTokenizer::Next(FToken& OutToken)
+{
+	while (Position < Text.Len())
+	{
+		const int32 LineBegin = Position;
+		int32 LineLen = 0;
+		while (LineBegin + LineLen < Text.Len() && Text[LineBegin + LineLen] != TEXT('\n'))
+		{
+			LineLen++;
+		}
+		Position = FMath::Min(LineBegin + LineLen + 1, Text.Len());
+
+		const FStringView Line = Text.Mid(LineBegin, LineLen).TrimStartAndEnd();
+		if (Line.IsEmpty() || Line.StartsWith(TEXT(';')))
+		{
+			continue;
+		}
+
+		OutToken.LineBegin = LineBegin;
+		OutToken.LineEnd = Position;
+
+		if (Line.StartsWith(TEXT('[')))
+		{
+			OutToken.Type = ETokenType::Section;
+			OutToken.Name = Line.EndsWith(TEXT(']')) ? Line.Mid(1, Line.Len() - 2) : FStringView();
+			OutToken.Key = FStringView();
+			OutToken.Value = FStringView();
+			return true;
+		}
+
+		int32 EqualsIndex = INDEX_NONE;
+		if (!Line.FindChar(TEXT('='), EqualsIndex))
+		{
+			continue;
+		}
+
+		OutToken.Type = ETokenType::KeyValue;
+		OutToken.Name = FStringView();
+		OutToken.Key = Line.Left(EqualsIndex).TrimStartAndEnd();
+		OutToken.Value = Line.RightChop(EqualsIndex + 1).TrimStartAndEnd();
+		return true;
+	}
+
+	return false;
+}
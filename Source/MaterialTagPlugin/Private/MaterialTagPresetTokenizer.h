@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Streaming tokenizer for the preset INI format.
+ * Walks a single text buffer and hands out FStringView slices into it, so tokenizing allocates nothing.
+ * Blank lines, ';' comments and lines without '=' are skipped.
+ */
+class FMaterialTagPresetTokenizer
+{
+public:
+	enum class ETokenType : uint8
+	{
+		/** "[Name]" line. Name is empty if the header is malformed (no closing bracket or empty). */
+		Section,
+		/** "Key=Value" line, both sides trimmed */
+		KeyValue,
+	};
+
+	struct FToken
+	{
+		ETokenType Type = ETokenType::Section;
+		FStringView Name;
+		FStringView Key;
+		FStringView Value;
+
+		/** Offset of the token's line start within the tokenized text */
+		int32 LineBegin = 0;
+		/** Offset just past the token's line terminator */
+		int32 LineEnd = 0;
+	};
+
+	explicit FMaterialTagPresetTokenizer(FStringView InText)
+		: Text(InText)
+	{
+	}
+
+	/** Advance to the next section or key/value line. Returns false at end of text. */
+	bool Next(FToken& OutToken);
+
+	/** Split a comma-separated value into trimmed, non-empty slices */
+	template <typename FuncType>
+	static void ForEachListItem(FStringView Value, FuncType&& Func)
+	{
+		while (!Value.IsEmpty())
+		{
+			int32 Comma = INDEX_NONE;
+			FStringView Item = Value;
+			if (Value.FindChar(TEXT(','), Comma))
+			{
+				Item = Value.Left(Comma);
+				Value.RightChopInline(Comma + 1);
+			}
+			else
+			{
+				Value = FStringView();
+			}
+
+			Item = Item.TrimStartAndEnd();
+			if (!Item.IsEmpty())
+			{
+				Func(Item);
+			}
+		}
+	}
+
+private:
+	FStringView Text;
+	int32 Position = 0;
+};
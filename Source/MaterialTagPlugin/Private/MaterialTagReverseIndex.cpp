@@ -0,0 +1,268 @@
+#include "MaterialTagReverseIndex.h"
+
+#if WITH_EDITOR
+
+#include "MaterialTagAssetUserData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/ARFilter.h"
+#include "Engine/SkeletalMesh.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+	IAssetRegistry& GetAssetRegistry()
+	{
+		return FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	}
+
+	bool IsSkeletalMeshAsset(const FAssetData& AssetData)
+	{
+		return AssetData.AssetClassPath == USkeletalMesh::StaticClass()->GetClassPathName();
+	}
+}
+
+FMaterialTagReverseIndex& FMaterialTagReverseIndex::Get()
+{
+	static FMaterialTagReverseIndex Instance;
+	return Instance;
+}
+
+void FMaterialTagReverseIndex::Initialize()
+{
+	IAssetRegistry& AssetRegistry = GetAssetRegistry();
+
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FMaterialTagReverseIndex::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FMaterialTagReverseIndex::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FMaterialTagReverseIndex::OnAssetRenamed);
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FMaterialTagReverseIndex::OnAssetUpdated);
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FMaterialTagReverseIndex::OnPackageSaved);
+
+	// The startup scan reports every asset as added; build once at the end instead
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FMaterialTagReverseIndex::BuildFromRegistry);
+	}
+	else
+	{
+		BuildFromRegistry();
+	}
+}
+
+void FMaterialTagReverseIndex::Shutdown()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+
+	FilesLoadedHandle.Reset();
+	AssetAddedHandle.Reset();
+	AssetRemovedHandle.Reset();
+	AssetRenamedHandle.Reset();
+	AssetUpdatedHandle.Reset();
+	PackageSavedHandle.Reset();
+
+	Meshes.Empty();
+	MeshesByTag.Empty();
+	bBuilt = false;
+}
+
+void FMaterialTagReverseIndex::BuildFromRegistry()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	Meshes.Reset();
+	MeshesByTag.Reset();
+
+	// Only meshes that carry the slot list; an unset value matches any
+	FARFilter Filter;
+	Filter.ClassPaths.Add(USkeletalMesh::StaticClass()->GetClassPathName());
+	Filter.TagsAndValues.Add(UMaterialTagAssetUserData::SlotTagsRegistryTag);
+
+	TArray<FAssetData> Assets;
+	GetAssetRegistry().GetAssets(Filter, Assets);
+
+	for (const FAssetData& AssetData : Assets)
+	{
+		FString Value;
+		if (AssetData.GetTagValue(UMaterialTagAssetUserData::SlotTagsRegistryTag, Value))
+		{
+			TArray<FMaterialTagRegistrySlot> Slots;
+			UMaterialTagAssetUserData::ParseSlotTagsRegistryValue(Value, Slots);
+			SetMesh(AssetData.GetSoftObjectPath(), MoveTemp(Slots));
+		}
+	}
+
+	bBuilt = true;
+	UE_LOG(LogTemp, Log, TEXT("MaterialTagReverseIndex: Indexed %d tagged mesh(es) under %d tag(s) in %.1f ms"),
+		Meshes.Num(), MeshesByTag.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	IndexChangedEvent.Broadcast();
+}
+
+TArray<FMaterialTagSlotRef> FMaterialTagReverseIndex::FindSlots(const FGameplayTag& Tag) const
+{
+	TArray<FMaterialTagSlotRef> Result;
+
+	const TSet<FSoftObjectPath>* MeshPaths = MeshesByTag.Find(Tag);
+	if (!MeshPaths) return Result;
+
+	// Path strings are built once per mesh rather than once per comparison
+	TArray<TPair<FString, const FSoftObjectPath*>> SortedMeshes;
+	SortedMeshes.Reserve(MeshPaths->Num());
+	for (const FSoftObjectPath& MeshPath : *MeshPaths)
+	{
+		SortedMeshes.Emplace(MeshPath.ToString(), &MeshPath);
+	}
+	SortedMeshes.Sort([](const TPair<FString, const FSoftObjectPath*>& A, const TPair<FString, const FSoftObjectPath*>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	for (const TPair<FString, const FSoftObjectPath*>& SortedMesh : SortedMeshes)
+	{
+		const FMeshEntry& Entry = Meshes.FindChecked(*SortedMesh.Value);
+		for (const FMaterialTagRegistrySlot& Slot : Entry.Slots)
+		{
+			// HasTag matches Tag itself or any tag below it
+			if (Slot.Tags.HasTag(Tag))
+			{
+				FMaterialTagSlotRef& Ref = Result.AddDefaulted_GetRef();
+				Ref.Mesh = *SortedMesh.Value;
+				Ref.SlotIndex = Slot.SlotIndex;
+				Ref.SlotName = Slot.SlotName;
+			}
+		}
+	}
+	return Result;
+}
+
+void FMaterialTagReverseIndex::SetMesh(const FSoftObjectPath& MeshPath, TArray<FMaterialTagRegistrySlot>&& Slots)
+{
+	RemoveMesh(MeshPath);
+	if (Slots.Num() == 0) return;
+
+	FMeshEntry& Entry = Meshes.Add(MeshPath);
+	Entry.Slots = MoveTemp(Slots);
+	for (const FMaterialTagRegistrySlot& Slot : Entry.Slots)
+	{
+		Entry.IndexedTags.AppendTags(Slot.Tags.GetGameplayTagParents());
+	}
+
+	for (const FGameplayTag& Tag : Entry.IndexedTags)
+	{
+		MeshesByTag.FindOrAdd(Tag).Add(MeshPath);
+	}
+}
+
+void FMaterialTagReverseIndex::RemoveMesh(const FSoftObjectPath& MeshPath)
+{
+	FMeshEntry Removed;
+	if (!Meshes.RemoveAndCopyValue(MeshPath, Removed)) return;
+
+	for (const FGameplayTag& Tag : Removed.IndexedTags)
+	{
+		if (TSet<FSoftObjectPath>* MeshPaths = MeshesByTag.Find(Tag))
+		{
+			MeshPaths->Remove(MeshPath);
+			if (MeshPaths->Num() == 0)
+			{
+				MeshesByTag.Remove(Tag);
+			}
+		}
+	}
+}
+
+void FMaterialTagReverseIndex::UpdateFromAssetData(const FAssetData& AssetData)
+{
+	if (!IsSkeletalMeshAsset(AssetData)) return;
+
+	TArray<FMaterialTagRegistrySlot> Slots;
+	FString Value;
+	if (AssetData.GetTagValue(UMaterialTagAssetUserData::SlotTagsRegistryTag, Value))
+	{
+		UMaterialTagAssetUserData::ParseSlotTagsRegistryValue(Value, Slots);
+	}
+	SetMesh(AssetData.GetSoftObjectPath(), MoveTemp(Slots));
+	IndexChangedEvent.Broadcast();
+}
+
+void FMaterialTagReverseIndex::OnAssetAdded(const FAssetData& AssetData)
+{
+	if (bBuilt)
+	{
+		UpdateFromAssetData(AssetData);
+	}
+}
+
+void FMaterialTagReverseIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	if (bBuilt && IsSkeletalMeshAsset(AssetData))
+	{
+		RemoveMesh(AssetData.GetSoftObjectPath());
+		IndexChangedEvent.Broadcast();
+	}
+}
+
+void FMaterialTagReverseIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	if (bBuilt && IsSkeletalMeshAsset(AssetData))
+	{
+		RemoveMesh(FSoftObjectPath(OldObjectPath));
+		UpdateFromAssetData(AssetData);
+	}
+}
+
+void FMaterialTagReverseIndex::OnAssetUpdated(const FAssetData& AssetData)
+{
+	if (bBuilt)
+	{
+		UpdateFromAssetData(AssetData);
+	}
+}
+
+void FMaterialTagReverseIndex::OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	if (!bBuilt || !Package || SaveContext.IsProceduralSave()) return;
+
+	// Read the saved mesh directly; the registry may not have re-gathered its tags yet
+	bool bChanged = false;
+	ForEachObjectWithPackage(Package, [this, &bChanged](UObject* Object)
+	{
+		USkeletalMesh* Mesh = Cast<USkeletalMesh>(Object);
+		if (!Mesh) return true;
+
+		TArray<FMaterialTagRegistrySlot> Slots;
+		if (const UMaterialTagAssetUserData* UserData = Mesh->GetAssetUserData<UMaterialTagAssetUserData>())
+		{
+			TArray<UObject::FAssetRegistryTag> Tags;
+			UserData->GetMeshAssetRegistryTags(Tags);
+			for (const UObject::FAssetRegistryTag& Tag : Tags)
+			{
+				if (Tag.Name == UMaterialTagAssetUserData::SlotTagsRegistryTag)
+				{
+					UMaterialTagAssetUserData::ParseSlotTagsRegistryValue(Tag.Value, Slots);
+				}
+			}
+		}
+		SetMesh(FSoftObjectPath(Mesh), MoveTemp(Slots));
+		bChanged = true;
+		return true;
+	}, false);
+
+	if (bChanged)
+	{
+		IndexChangedEvent.Broadcast();
+	}
+}
+
+#endif // WITH_EDITOR
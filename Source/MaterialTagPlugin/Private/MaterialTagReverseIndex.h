@@ -0,0 +1,95 @@
+#pragma once
+
+#if WITH_EDITOR
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "UObject/SoftObjectPath.h"
+#include "MaterialTagAssetUserData.h"
+
+struct FAssetData;
+class UPackage;
+class FObjectPostSaveContext;
+
+/** A material slot on a mesh, as returned by FMaterialTagReverseIndex::FindSlots */
+struct FMaterialTagSlotRef
+{
+	FSoftObjectPath Mesh;
+	int32 SlotIndex = INDEX_NONE;
+	FName SlotName;
+};
+
+/**
+ * Editor-side index from MaterialTag to the mesh slots that use it, answered without loading any mesh.
+ *
+ * Built once from the MaterialTagSlotTags asset registry value every tagged mesh carries (see
+ * UMaterialTagAssetUserData::GetMeshAssetRegistryTags), then kept current from asset registry
+ * add/remove/rename/update events and package saves.
+ *
+ * Each mesh is listed under every one of its slot tags and their parents, so a query for T is a
+ * single map lookup followed by a scan of just the meshes that use T or a child of T.
+ */
+class FMaterialTagReverseIndex
+{
+public:
+	static FMaterialTagReverseIndex& Get();
+
+	/** Start listening to the asset registry; the index is built as soon as the initial scan has finished */
+	void Initialize();
+
+	/** Stop listening and drop the index */
+	void Shutdown();
+
+	/** True once the initial build from the asset registry is done */
+	bool IsBuilt() const { return bBuilt; }
+
+	/** Every slot whose tags include Tag or one of its children, ordered by mesh path, then slot index */
+	TArray<FMaterialTagSlotRef> FindSlots(const FGameplayTag& Tag) const;
+
+	/** Number of meshes with at least one tagged slot */
+	int32 GetNumMeshes() const { return Meshes.Num(); }
+
+	/** Broadcast on the game thread after the index was built or a mesh changed */
+	DECLARE_MULTICAST_DELEGATE(FOnIndexChanged);
+	FOnIndexChanged& OnIndexChanged() { return IndexChangedEvent; }
+
+private:
+	struct FMeshEntry
+	{
+		TArray<FMaterialTagRegistrySlot> Slots;
+
+		/** Slot tags plus all their parents: the MeshesByTag keys this mesh is listed under */
+		FGameplayTagContainer IndexedTags;
+	};
+
+	void BuildFromRegistry();
+
+	/** Replace a mesh's slots; no slots removes the mesh */
+	void SetMesh(const FSoftObjectPath& MeshPath, TArray<FMaterialTagRegistrySlot>&& Slots);
+	void RemoveMesh(const FSoftObjectPath& MeshPath);
+
+	/** Re-read a mesh from its registry entry; ignored for anything that isn't a skeletal mesh */
+	void UpdateFromAssetData(const FAssetData& AssetData);
+
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnAssetUpdated(const FAssetData& AssetData);
+	void OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext);
+
+	TMap<FSoftObjectPath, FMeshEntry> Meshes;
+	TMap<FGameplayTag, TSet<FSoftObjectPath>> MeshesByTag;
+
+	bool bBuilt = false;
+
+	FOnIndexChanged IndexChangedEvent;
+
+	FDelegateHandle FilesLoadedHandle;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+	FDelegateHandle PackageSavedHandle;
+};
+
+#endif // WITH_EDITOR
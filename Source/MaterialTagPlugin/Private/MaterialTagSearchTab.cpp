@@ -0,0 +1,192 @@
+#include "MaterialTagSearchTab.h"
+
+#if WITH_EDITOR
+
+#include "Editor.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "GameplayTagsManager.h"
+#include "Framework/Docking/TabManager.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STableRow.h"
+
+#define LOCTEXT_NAMESPACE "MaterialTagSearch"
+
+const FName SMaterialTagSearch::TabName(TEXT("MaterialTagSearch"));
+
+namespace
+{
+	const FName MeshColumn(TEXT("Mesh"));
+	const FName SlotIndexColumn(TEXT("SlotIndex"));
+	const FName SlotNameColumn(TEXT("SlotName"));
+
+	class SMaterialTagSearchRow : public SMultiColumnTableRow<TSharedPtr<FMaterialTagSlotRef>>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SMaterialTagSearchRow) {}
+			SLATE_ARGUMENT(TSharedPtr<FMaterialTagSlotRef>, Item)
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+		{
+			Item = InArgs._Item;
+			SMultiColumnTableRow<TSharedPtr<FMaterialTagSlotRef>>::Construct(FSuperRowType::FArguments(), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			FText Text;
+			if (ColumnName == MeshColumn)
+			{
+				Text = FText::FromString(Item->Mesh.GetLongPackageName());
+			}
+			else if (ColumnName == SlotIndexColumn)
+			{
+				Text = FText::AsNumber(Item->SlotIndex);
+			}
+			else
+			{
+				Text = FText::FromName(Item->SlotName);
+			}
+
+			return SNew(STextBlock)
+				.Text(Text)
+				.Margin(FMargin(4, 1));
+		}
+
+	private:
+		TSharedPtr<FMaterialTagSlotRef> Item;
+	};
+}
+
+TSharedRef<SDockTab> SMaterialTagSearch::SpawnTab(const FSpawnTabArgs& Args)
+{
+	return SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		[
+			SNew(SMaterialTagSearch)
+		];
+}
+
+SMaterialTagSearch::~SMaterialTagSearch()
+{
+	FMaterialTagReverseIndex::Get().OnIndexChanged().Remove(IndexChangedHandle);
+}
+
+void SMaterialTagSearch::Construct(const FArguments& InArgs)
+{
+	IndexChangedHandle = FMaterialTagReverseIndex::Get().OnIndexChanged().AddSP(this, &SMaterialTagSearch::RunQuery);
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.0f)
+		[
+			SNew(SEditableTextBox)
+			.HintText(LOCTEXT("QueryHint", "MaterialTag (children match too)"))
+			.OnTextChanged(this, &SMaterialTagSearch::OnQueryTextChanged)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.0f, 0.0f, 4.0f, 4.0f)
+		[
+			SNew(STextBlock)
+			.Text(this, &SMaterialTagSearch::GetStatusText)
+			.ColorAndOpacity(FLinearColor(0.6f, 0.6f, 0.6f))
+		]
+		+ SVerticalBox::Slot()
+		.FillHeight(1.0f)
+		[
+			SAssignNew(ResultList, SListView<FResultPtr>)
+			.ListItemsSource(&Results)
+			.SelectionMode(ESelectionMode::Single)
+			.OnGenerateRow(this, &SMaterialTagSearch::GenerateRow)
+			.OnMouseButtonDoubleClick(this, &SMaterialTagSearch::OnRowDoubleClicked)
+			.HeaderRow
+			(
+				SNew(SHeaderRow)
+				+ SHeaderRow::Column(MeshColumn).DefaultLabel(LOCTEXT("MeshColumn", "Mesh")).FillWidth(0.6f)
+				+ SHeaderRow::Column(SlotIndexColumn).DefaultLabel(LOCTEXT("SlotIndexColumn", "Slot")).FixedWidth(48.0f)
+				+ SHeaderRow::Column(SlotNameColumn).DefaultLabel(LOCTEXT("SlotNameColumn", "Slot Name")).FillWidth(0.4f)
+			)
+		]
+	];
+
+	RunQuery();
+}
+
+void SMaterialTagSearch::OnQueryTextChanged(const FText& Text)
+{
+	QueryText = Text.ToString().TrimStartAndEnd();
+	RunQuery();
+}
+
+void SMaterialTagSearch::RunQuery()
+{
+	Results.Reset();
+
+	const FMaterialTagReverseIndex& Index = FMaterialTagReverseIndex::Get();
+	if (!Index.IsBuilt())
+	{
+		StatusText = LOCTEXT("IndexBuilding", "Waiting for the asset registry scan...");
+	}
+	else if (QueryText.IsEmpty())
+	{
+		StatusText = FText::Format(LOCTEXT("IndexReady", "{0} tagged mesh(es) indexed"), Index.GetNumMeshes());
+	}
+	else
+	{
+		const FGameplayTag Tag = UGameplayTagsManager::Get().RequestGameplayTag(FName(*QueryText), false);
+		if (!Tag.IsValid())
+		{
+			StatusText = LOCTEXT("UnknownTag", "Not a registered gameplay tag");
+		}
+		else
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			TArray<FMaterialTagSlotRef> Slots = Index.FindSlots(Tag);
+			const double QueryMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			TSet<FSoftObjectPath> MeshPaths;
+			Results.Reserve(Slots.Num());
+			for (FMaterialTagSlotRef& Slot : Slots)
+			{
+				MeshPaths.Add(Slot.Mesh);
+				Results.Add(MakeShared<FMaterialTagSlotRef>(MoveTemp(Slot)));
+			}
+
+			FNumberFormattingOptions MsFormat;
+			MsFormat.MaximumFractionalDigits = 2;
+			StatusText = FText::Format(LOCTEXT("QueryResult", "{0} slot(s) on {1} mesh(es) in {2} ms"),
+				Results.Num(), MeshPaths.Num(), FText::AsNumber(QueryMs, &MsFormat));
+		}
+	}
+
+	if (ResultList.IsValid())
+	{
+		ResultList->RequestListRefresh();
+	}
+}
+
+TSharedRef<ITableRow> SMaterialTagSearch::GenerateRow(FResultPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SMaterialTagSearchRow, OwnerTable)
+		.Item(Item);
+}
+
+void SMaterialTagSearch::OnRowDoubleClicked(FResultPtr Item)
+{
+	if (Item.IsValid() && GEditor)
+	{
+		GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(Item->Mesh);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
+
+#endif // WITH_EDITOR
@@ -0,0 +1,53 @@
+#pragma once
+
+#if WITH_EDITOR
+
+#include "CoreMinimal.h"
+#include "Widgets/DeclarativeSyntaxSupport.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "MaterialTagReverseIndex.h"
+
+class SDockTab;
+class FSpawnTabArgs;
+
+/**
+ * "Material Tag Search" editor tab: type a MaterialTag and list every mesh slot that uses it
+ * or one of its children, answered from FMaterialTagReverseIndex without loading meshes.
+ * Double-click a row to open the mesh.
+ */
+class SMaterialTagSearch : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SMaterialTagSearch) {}
+	SLATE_END_ARGS()
+
+	static const FName TabName;
+
+	/** Nomad tab spawner registered by the module */
+	static TSharedRef<SDockTab> SpawnTab(const FSpawnTabArgs& Args);
+
+	virtual ~SMaterialTagSearch() override;
+
+	void Construct(const FArguments& InArgs);
+
+private:
+	using FResultPtr = TSharedPtr<FMaterialTagSlotRef>;
+
+	void OnQueryTextChanged(const FText& Text);
+	void RunQuery();
+
+	TSharedRef<ITableRow> GenerateRow(FResultPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnRowDoubleClicked(FResultPtr Item);
+
+	FText GetStatusText() const { return StatusText; }
+
+	FString QueryText;
+	FText StatusText;
+	TArray<FResultPtr> Results;
+	TSharedPtr<SListView<FResultPtr>> ResultList;
+
+	FDelegateHandle IndexChangedHandle;
+};
+
+#endif // WITH_EDITOR
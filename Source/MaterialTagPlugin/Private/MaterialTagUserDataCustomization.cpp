@@ -2,15 +2,15 @@
 
 #include "MaterialTagUserDataCustomization.h"
 #include "MaterialTagAssetUserData.h"
+#include "MaterialTagPresetDatabase.h"
 #include "MaterialTagDragDrop.h"
 #include "DetailWidgetRow.h"
 #include "IDetailChildrenBuilder.h"
+#include "IPropertyUtilities.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Layout/SWrapBox.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/SBoxPanel.h"
-#include "Misc/Paths.h"
-#include "Misc/FileHelper.h"
 #include "Fonts/SlateFontInfo.h"
 #include "Engine/SkeletalMesh.h"
 #include "Engine/SkinnedAssetCommon.h"
@@ -22,9 +22,23 @@ TSharedRef<IPropertyTypeCustomization> FPresetTagDisplayCustomization::MakeInsta
 	return MakeShareable(new FPresetTagDisplayCustomization());
 }
 
+FPresetTagDisplayCustomization::~FPresetTagDisplayCustomization()
+{
+	if (PresetsChangedHandle.IsValid())
+	{
+		FMaterialTagPresetDatabase::Get().OnPresetsChanged().Remove(PresetsChangedHandle);
+	}
+}
+
 void FPresetTagDisplayCustomization::CustomizeHeader(TSharedRef<IPropertyHandle> PropertyHandle, FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& CustomizationUtils)
 {
 	StructHandle = PropertyHandle;
+	PropertyUtilities = CustomizationUtils.GetPropertyUtilities();
+
+	if (!PresetsChangedHandle.IsValid())
+	{
+		PresetsChangedHandle = FMaterialTagPresetDatabase::Get().OnPresetsChanged().AddRaw(this, &FPresetTagDisplayCustomization::OnPresetsChanged);
+	}
 
 	FString MeshName = GetPresetMeshName();
 
@@ -44,13 +58,32 @@ void FPresetTagDisplayCustomization::CustomizeHeader(TSharedRef<IPropertyHandle>
 		return;
 	}
 
-	// Build full slot table from mesh + INI
-	UMaterialTagAssetUserData* UserData = GetUserData();
+	// Build full slot table from the cached preset record. While a worker loads it, show a placeholder;
+	// OnPresetsChanged refreshes the panel once the preset arrives.
+	TSharedPtr<const FMaterialTagPreset> Preset;
+	if (FMaterialTagPresetDatabase::Get().TryFindPreset(MeshName, Preset) == EMaterialTagPresetLookup::Pending)
+	{
+		HeaderRow
+			.NameContent()
+			[
+				PropertyHandle->CreatePropertyNameWidget()
+			]
+			.ValueContent()
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(FString::Printf(TEXT("Loading preset '%s'..."), *MeshName)))
+				.ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f))
+			];
+		return;
+	}
+
 	TArray<FPresetSlotInfo> SlotTable;
-	TSet<FString> UniqueTags;
-	BuildSlotTable(UserData, MeshName, SlotTable, UniqueTags);
+	if (Preset.IsValid())
+	{
+		BuildSlotTable(*Preset, SlotTable);
+	}
 
-	if (SlotTable.Num() == 0 && UniqueTags.Num() == 0)
+	if (SlotTable.Num() == 0 && (!Preset.IsValid() || Preset->Tags.Num() == 0))
 	{
 		HeaderRow
 			.NameContent()
@@ -73,7 +106,7 @@ void FPresetTagDisplayCustomization::CustomizeHeader(TSharedRef<IPropertyHandle>
 		int32 MaxLen = 12;
 		for (const auto& Slot : SlotTable)
 		{
-			MaxLen = FMath::Max(MaxLen, Slot.SlotName.Len());
+			MaxLen = FMath::Max(MaxLen, (int32)Slot.SlotName.GetStringLength());
 		}
 
 		TableText += FString::Printf(TEXT("  %-4s %-*s  %s\n"), TEXT("#"), MaxLen, TEXT("Slot Name"), TEXT("Tag"));
@@ -83,33 +116,44 @@ void FPresetTagDisplayCustomization::CustomizeHeader(TSharedRef<IPropertyHandle>
 		{
 			FString TagDisplay = Slot.Tags.IsEmpty() ? TEXT("(none)") : Slot.Tags;
 			TagDisplay.ReplaceInline(TEXT(","), TEXT(", "));
-			TableText += FString::Printf(TEXT("  %-4d %-*s  %s\n"), Slot.Index, MaxLen, *Slot.SlotName, *TagDisplay);
+			TableText += FString::Printf(TEXT("  %-4d %-*s  %s\n"), Slot.Index, MaxLen, *Slot.SlotName.ToString(), *TagDisplay);
 		}
 	}
 
-	// Build tag pills from unique tags
+	// Build tag pills from the preset's tag lines, sorted by name
 	TSharedRef<SWrapBox> WrapBox = SNew(SWrapBox)
 		.UseAllottedSize(true);
 
-	TArray<FString> SortedTags = UniqueTags.Array();
-	SortedTags.Sort();
-
-	// Also get the tag->slots map for tooltip hints
-	TMap<FString, TArray<FString>> TagToSlots = GetTagToSlotsMap(MeshName);
+	TArray<const FMaterialTagPresetTag*> SortedTags;
+	for (const FMaterialTagPresetTag& Entry : Preset->Tags)
+	{
+		SortedTags.Add(&Entry);
+	}
+	SortedTags.Sort([](const FMaterialTagPresetTag& A, const FMaterialTagPresetTag& B)
+	{
+		return A.TagName.LexicalLess(B.TagName);
+	});
 
-	for (const FString& TagName : SortedTags)
+	for (const FMaterialTagPresetTag* Entry : SortedTags)
 	{
+		// The tag's slot list doubles as tooltip hint
 		FString SlotHint;
-		if (const TArray<FString>* Slots = TagToSlots.Find(TagName))
+		for (FName Slot : Entry->Slots)
 		{
-			SlotHint = FString::Join(*Slots, TEXT(", "));
+			if (!SlotHint.IsEmpty())
+			{
+				SlotHint += TEXT(", ");
+			}
+			SlotHint += Slot.ToString();
 		}
 
+		// Carries the tag resolved at load; unknown tags render as disabled pills
 		WrapBox->AddSlot()
 		.Padding(2.0f)
 		[
 			SNew(STagPill)
-			.TagName(TagName)
+			.TagName(Entry->TagName)
+			.Tag(Entry->Tag)
 			.SlotHint(SlotHint)
 		];
 	}
@@ -167,6 +211,25 @@ void FPresetTagDisplayCustomization::CustomizeChildren(TSharedRef<IPropertyHandl
 {
 }
 
+void FPresetTagDisplayCustomization::OnPresetsChanged(const TSet<FString>& ChangedSections)
+{
+	const FString MeshName = GetPresetMeshName();
+	if (MeshName.IsEmpty() || !ChangedSections.Contains(FMaterialTagPresetDatabase::FoldSectionName(MeshName)))
+	{
+		return;
+	}
+
+	if (UMaterialTagAssetUserData* UserData = GetUserData())
+	{
+		UserData->UpdatePresetInfo();
+	}
+
+	if (PropertyUtilities.IsValid())
+	{
+		PropertyUtilities->ForceRefresh();
+	}
+}
+
 FString FPresetTagDisplayCustomization::GetPresetMeshName() const
 {
 	if (!StructHandle.IsValid()) return FString();
@@ -200,149 +263,31 @@ UMaterialTagAssetUserData* FPresetTagDisplayCustomization::GetUserData() const
 	return nullptr;
 }
 
-void FPresetTagDisplayCustomization::BuildSlotTable(UMaterialTagAssetUserData* UserData, const FString& MeshName, TArray<FPresetSlotInfo>& OutSlots, TSet<FString>& OutUniqueTags)
+void FPresetTagDisplayCustomization::BuildSlotTable(const FMaterialTagPreset& Preset, TArray<FPresetSlotInfo>& OutSlots)
 {
 	OutSlots.Empty();
-	OutUniqueTags.Empty();
-
-	// Get tag->slots map from the selected preset INI
-	TMap<FString, TArray<FString>> TagToSlots = GetTagToSlotsMap(MeshName);
-
-	// Build reverse map: slot name -> tags
-	TMap<FString, TArray<FString>> SlotToTags;
-	for (const auto& Pair : TagToSlots)
-	{
-		OutUniqueTags.Add(Pair.Key);
-		for (const FString& SlotName : Pair.Value)
-		{
-			SlotToTags.FindOrAdd(SlotName.TrimStartAndEnd()).AddUnique(Pair.Key);
-		}
-	}
 
 	// Use the PRESET's full slot list from the INI (Slot_N keys)
-	TArray<FString> PresetSlots = GetPresetSlotList(MeshName);
-
-	for (int32 i = 0; i < PresetSlots.Num(); i++)
+	for (int32 i = 0; i < Preset.Slots.Num(); i++)
 	{
 		FPresetSlotInfo Info;
 		Info.Index = i;
-		Info.SlotName = PresetSlots[i];
-
-		if (const TArray<FString>* Tags = SlotToTags.Find(Info.SlotName))
-		{
-			Info.Tags = FString::Join(*Tags, TEXT(", "));
-		}
-
-		OutSlots.Add(Info);
-	}
-}
-
-TArray<FString> FPresetTagDisplayCustomization::GetPresetSlotList(const FString& MeshName)
-{
-	TArray<FString> Result;
-
-	FString IniPath = GetPresetIniPath();
-	if (!FPaths::FileExists(IniPath))
-		return Result;
+		Info.SlotName = Preset.Slots[i];
 
-	TArray<FString> Lines;
-	FFileHelper::LoadFileToStringArray(Lines, *IniPath);
-
-	FString SectionHeader = FString::Printf(TEXT("[%s]"), *MeshName);
-	bool bInSection = false;
-	int32 SlotCount = 0;
-
-	for (const FString& Line : Lines)
-	{
-		FString Trimmed = Line.TrimStartAndEnd();
-
-		if (Trimmed.StartsWith(TEXT("[")))
-		{
-			if (bInSection) break;
-			if (Trimmed.Equals(SectionHeader, ESearchCase::IgnoreCase))
-				bInSection = true;
-			continue;
-		}
-
-		if (!bInSection) continue;
-		if (Trimmed.IsEmpty() || Trimmed.StartsWith(TEXT(";"))) continue;
-
-		FString Key, Value;
-		if (!Trimmed.Split(TEXT("="), &Key, &Value)) continue;
-		Key = Key.TrimStartAndEnd();
-		Value = Value.TrimStartAndEnd();
-
-		if (Key == TEXT("SlotCount"))
+		if (const TArray<FGameplayTag>* Tags = Preset.SlotToTags.Find(Info.SlotName))
 		{
-			SlotCount = FCString::Atoi(*Value);
-			Result.SetNum(SlotCount);
-		}
-		else if (Key.StartsWith(TEXT("Slot_")))
-		{
-			int32 Idx = FCString::Atoi(*Key.Mid(5));
-			if (Result.IsValidIndex(Idx))
+			for (const FGameplayTag& Tag : *Tags)
 			{
-				Result[Idx] = Value;
+				if (!Info.Tags.IsEmpty())
+				{
+					Info.Tags += TEXT(", ");
+				}
+				Info.Tags += Tag.ToString();
 			}
 		}
-	}
 
-	return Result;
-}
-
-TMap<FString, TArray<FString>> FPresetTagDisplayCustomization::GetTagToSlotsMap(const FString& MeshName)
-{
-	TMap<FString, TArray<FString>> Result;
-
-	FString IniPath = GetPresetIniPath();
-	if (!FPaths::FileExists(IniPath))
-		return Result;
-
-	TArray<FString> Lines;
-	FFileHelper::LoadFileToStringArray(Lines, *IniPath);
-
-	FString SectionHeader = FString::Printf(TEXT("[%s]"), *MeshName);
-	bool bInSection = false;
-
-	for (const FString& Line : Lines)
-	{
-		FString Trimmed = Line.TrimStartAndEnd();
-
-		if (Trimmed.StartsWith(TEXT("[")))
-		{
-			if (bInSection) break;
-			if (Trimmed.Equals(SectionHeader, ESearchCase::IgnoreCase))
-				bInSection = true;
-			continue;
-		}
-
-		if (!bInSection) continue;
-		if (Trimmed.IsEmpty() || Trimmed.StartsWith(TEXT(";"))) continue;
-
-		// Skip Slot_N and SlotCount keys (new format)
-		if (Trimmed.StartsWith(TEXT("Slot_")) || Trimmed.StartsWith(TEXT("SlotCount")))
-			continue;
-
-		FString Key, Value;
-		if (Trimmed.Split(TEXT("="), &Key, &Value))
-		{
-			Key = Key.TrimStartAndEnd();
-			Value = Value.TrimStartAndEnd();
-
-			TArray<FString> Slots;
-			Value.ParseIntoArray(Slots, TEXT(","));
-			for (FString& S : Slots) S = S.TrimStartAndEnd();
-
-			Result.Add(Key, Slots);
-		}
+		OutSlots.Add(Info);
 	}
-
-	return Result;
-}
-
-FString FPresetTagDisplayCustomization::GetPresetIniPath()
-{
-	return FPaths::ProjectPluginsDir() / TEXT("MaterialTagPlugin") / TEXT("Config") / TEXT("MaterialTagPresets.ini");
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -9,12 +9,13 @@
 class FDetailWidgetRow;
 class IDetailChildrenBuilder;
 class UMaterialTagAssetUserData;
+struct FMaterialTagPreset;
 
 /** One slot in the full table: index, name, tag(s) */
 struct FPresetSlotInfo
 {
 	int32 Index;
-	FString SlotName;
+	FName SlotName;
 	FString Tags; // comma-separated, empty if none
 };
 
@@ -27,21 +28,14 @@ class FPresetTagDisplayCustomization : public IPropertyTypeCustomization
 public:
 	static TSharedRef<IPropertyTypeCustomization> MakeInstance();
 
+	virtual ~FPresetTagDisplayCustomization() override;
+
 	virtual void CustomizeHeader(TSharedRef<IPropertyHandle> PropertyHandle, FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& CustomizationUtils) override;
 	virtual void CustomizeChildren(TSharedRef<IPropertyHandle> PropertyHandle, IDetailChildrenBuilder& ChildBuilder, IPropertyTypeCustomizationUtils& CustomizationUtils) override;
 
 private:
-	/** Parse the INI to get tag->slot(s) map for the given mesh */
-	static TMap<FString, TArray<FString>> GetTagToSlotsMap(const FString& MeshName);
-
-	/** Read the full ordered slot list (Slot_N keys) from the INI for the given mesh */
-	static TArray<FString> GetPresetSlotList(const FString& MeshName);
-
-	/** Build the full slot table from the mesh materials + INI tag data */
-	static void BuildSlotTable(UMaterialTagAssetUserData* UserData, const FString& MeshName, TArray<FPresetSlotInfo>& OutSlots, TSet<FString>& OutUniqueTags);
-
-	/** Get the path to the preset INI file */
-	static FString GetPresetIniPath();
+	/** Build the full slot table from the preset's slot list + tag data */
+	static void BuildSlotTable(const FMaterialTagPreset& Preset, TArray<FPresetSlotInfo>& OutSlots);
 
 	/** Find the PresetMeshName from the parent UMaterialTagAssetUserData */
 	FString GetPresetMeshName() const;
@@ -49,7 +43,15 @@ private:
 	/** Find the UMaterialTagAssetUserData from the property handle chain */
 	UMaterialTagAssetUserData* GetUserData() const;
 
+	/** Refresh this panel if its preset was among the reloaded sections */
+	void OnPresetsChanged(const TSet<FString>& ChangedSections);
+
 	TSharedPtr<IPropertyHandle> StructHandle;
+
+	/** Cached property utilities for forcing refresh */
+	TSharedPtr<IPropertyUtilities> PropertyUtilities;
+
+	FDelegateHandle PresetsChangedHandle;
 };
 
 #endif // WITH_EDITOR
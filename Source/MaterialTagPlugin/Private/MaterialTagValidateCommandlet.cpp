@@ -0,0 +1,392 @@
+#include "MaterialTagValidateCommandlet.h"
+
+#if WITH_EDITOR
+#include "MaterialTagAssetPipeline.h"
+#include "MaterialTagAssetUserData.h"
+#include "MaterialTagPresetDatabase.h"
+#include "Engine/SkeletalMesh.h"
+#include "GameplayTagsManager.h"
+#include "Async/Async.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+	/** What the checks need from a mesh, copied on the game thread so they can run on a worker */
+	struct FMeshSnapshot
+	{
+		FString MeshPath;
+		TArray<FName> MeshSlots;
+
+		/** Selected or auto-matched preset name; empty if the mesh has neither */
+		FString PresetName;
+
+		/** PresetName resolved on the game thread; null if it is not in the database */
+		TSharedPtr<const FMaterialTagPreset> Preset;
+
+		struct FEntry
+		{
+			FName SlotName;
+			TArray<FName> TagNames;
+		};
+		TArray<FEntry> Entries;
+	};
+
+	struct FIssue
+	{
+		bool bError = false;
+		const TCHAR* Check = TEXT("");
+		FName SlotName;
+		FName TagName;
+		FString Message;
+	};
+
+	struct FMeshReport
+	{
+		FString MeshPath;
+		FString PresetName;
+		TArray<FIssue> Issues;
+	};
+
+	void AddIssue(FMeshReport& Report, bool bError, const TCHAR* Check, FName SlotName, FName TagName, FString&& Message)
+	{
+		FIssue& Issue = Report.Issues.AddDefaulted_GetRef();
+		Issue.bError = bError;
+		Issue.Check = Check;
+		Issue.SlotName = SlotName;
+		Issue.TagName = TagName;
+		Issue.Message = MoveTemp(Message);
+	}
+
+	/** Game thread only. Preset lookups for one run, so each distinct preset is resolved once and workers never touch the database. */
+	class FPresetResolver
+	{
+	public:
+		/** The selected preset, or the auto-match if nothing is selected */
+		void Resolve(const FString& MeshName, const FString& SelectedPreset, FString& OutPresetName, TSharedPtr<const FMaterialTagPreset>& OutPreset)
+		{
+			check(IsInGameThread());
+
+			OutPresetName = SelectedPreset;
+			if (OutPresetName.IsEmpty())
+			{
+				const TArray<FMaterialTagPresetCandidate> Candidates = Database.RankPresets(MeshName, 1);
+				if (Candidates.Num() > 0 && Candidates[0].Score >= FMaterialTagPresetDatabase::AutoMatchConfidence)
+				{
+					OutPresetName = Candidates[0].Name;
+				}
+			}
+			if (OutPresetName.IsEmpty())
+			{
+				OutPreset.Reset();
+				return;
+			}
+
+			const FString Key = FMaterialTagPresetDatabase::FoldSectionName(OutPresetName);
+			if (const TSharedPtr<const FMaterialTagPreset>* Cached = Presets.Find(Key))
+			{
+				OutPreset = *Cached;
+				return;
+			}
+			OutPreset = Database.FindPreset(OutPresetName);
+			Presets.Add(Key, OutPreset);
+		}
+
+	private:
+		FMaterialTagPresetDatabase& Database = FMaterialTagPresetDatabase::Get();
+
+		/** Folded preset name -> record; null for names the database does not have */
+		TMap<FString, TSharedPtr<const FMaterialTagPreset>> Presets;
+	};
+
+	FMeshSnapshot TakeSnapshot(const USkeletalMesh& Mesh, const UMaterialTagAssetUserData& UserData, FPresetResolver& Presets)
+	{
+		FMeshSnapshot Snapshot;
+		Snapshot.MeshPath = Mesh.GetPathName();
+		Presets.Resolve(Mesh.GetName(), UserData.PresetMeshName, Snapshot.PresetName, Snapshot.Preset);
+
+		for (const FSkeletalMaterial& Material : Mesh.GetMaterials())
+		{
+			Snapshot.MeshSlots.Add(Material.MaterialSlotName);
+		}
+
+		Snapshot.Entries.Reserve(UserData.MaterialSlotTags.Num());
+		for (const FMaterialSlotTagEntry& Entry : UserData.MaterialSlotTags)
+		{
+			FMeshSnapshot::FEntry& SnapshotEntry = Snapshot.Entries.AddDefaulted_GetRef();
+			SnapshotEntry.SlotName = Entry.MaterialSlotName;
+			for (const FGameplayTagEntry& TagEntry : Entry.GameplayTags)
+			{
+				SnapshotEntry.TagNames.Add(TagEntry.Tag.GetTagName());
+			}
+		}
+		return Snapshot;
+	}
+
+	/** Every check for one mesh. Runs on the thread pool: touches only the snapshot and the tag table. */
+	FMeshReport ValidateMesh(const FMeshSnapshot& Snapshot)
+	{
+		FMeshReport Report;
+		Report.MeshPath = Snapshot.MeshPath;
+
+		TSet<FName> MeshSlots;
+		MeshSlots.Append(Snapshot.MeshSlots);
+		UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+
+		// Slot names, duplicates and tag registration
+		TSet<FName> SeenSlots;
+		for (const FMeshSnapshot::FEntry& Entry : Snapshot.Entries)
+		{
+			if (!MeshSlots.Contains(Entry.SlotName))
+			{
+				AddIssue(Report, true, TEXT("MissingSlot"), Entry.SlotName, NAME_None,
+					FString::Printf(TEXT("Slot '%s' does not exist on the mesh"), *Entry.SlotName.ToString()));
+			}
+
+			bool bAlreadySeen = false;
+			SeenSlots.Add(Entry.SlotName, &bAlreadySeen);
+			if (bAlreadySeen)
+			{
+				AddIssue(Report, true, TEXT("DuplicateSlot"), Entry.SlotName, NAME_None,
+					FString::Printf(TEXT("Slot '%s' has more than one entry; only the first is used"), *Entry.SlotName.ToString()));
+			}
+
+			for (const FName& TagName : Entry.TagNames)
+			{
+				if (TagName.IsNone())
+				{
+					AddIssue(Report, false, TEXT("EmptyTag"), Entry.SlotName, NAME_None,
+						FString::Printf(TEXT("Slot '%s' has an empty tag entry"), *Entry.SlotName.ToString()));
+				}
+				else if (!TagsManager.RequestGameplayTag(TagName, false).IsValid())
+				{
+					AddIssue(Report, true, TEXT("UnknownTag"), Entry.SlotName, TagName,
+						FString::Printf(TEXT("Tag '%s' on slot '%s' is not a registered gameplay tag"), *TagName.ToString(), *Entry.SlotName.ToString()));
+				}
+			}
+		}
+
+		// Agreement with the selected preset, or the auto-match if nothing is selected
+		if (Snapshot.PresetName.IsEmpty())
+		{
+			return Report;
+		}
+
+		const TSharedPtr<const FMaterialTagPreset>& Preset = Snapshot.Preset;
+		if (!Preset.IsValid())
+		{
+			AddIssue(Report, false, TEXT("PresetNotFound"), NAME_None, NAME_None,
+				FString::Printf(TEXT("Preset '%s' is not in the preset database"), *Snapshot.PresetName));
+			return Report;
+		}
+		Report.PresetName = Preset->Name;
+
+		// First entry per slot, as the runtime lookups use
+		TMap<FName, const FMeshSnapshot::FEntry*> EntryBySlot;
+		for (const FMeshSnapshot::FEntry& Entry : Snapshot.Entries)
+		{
+			if (!EntryBySlot.Contains(Entry.SlotName))
+			{
+				EntryBySlot.Add(Entry.SlotName, &Entry);
+			}
+		}
+
+		TSet<FName> ReportedMissingSlots;
+		TMap<FName, TSet<FName>> PresetTagsBySlot;
+		for (const FMaterialTagPresetTag& PresetTag : Preset->Tags)
+		{
+			for (const FName& SlotName : PresetTag.Slots)
+			{
+				PresetTagsBySlot.FindOrAdd(SlotName).Add(PresetTag.TagName);
+
+				if (!MeshSlots.Contains(SlotName))
+				{
+					bool bAlreadyReported = false;
+					ReportedMissingSlots.Add(SlotName, &bAlreadyReported);
+					if (!bAlreadyReported)
+					{
+						AddIssue(Report, true, TEXT("PresetSlotMissing"), SlotName, NAME_None,
+							FString::Printf(TEXT("Preset '%s' tags slot '%s', which the mesh does not have"), *Preset->Name, *SlotName.ToString()));
+					}
+					continue;
+				}
+
+				const FMeshSnapshot::FEntry* const* Entry = EntryBySlot.Find(SlotName);
+				if (!Entry || !(*Entry)->TagNames.Contains(PresetTag.TagName))
+				{
+					AddIssue(Report, false, TEXT("PresetMismatch"), SlotName, PresetTag.TagName,
+						FString::Printf(TEXT("Slot '%s' is missing preset tag '%s'"), *SlotName.ToString(), *PresetTag.TagName.ToString()));
+				}
+			}
+		}
+
+		for (const TPair<FName, const FMeshSnapshot::FEntry*>& Pair : EntryBySlot)
+		{
+			const TSet<FName>* PresetTags = PresetTagsBySlot.Find(Pair.Key);
+			for (const FName& TagName : Pair.Value->TagNames)
+			{
+				if (!TagName.IsNone() && (!PresetTags || !PresetTags->Contains(TagName)))
+				{
+					AddIssue(Report, false, TEXT("PresetMismatch"), Pair.Key, TagName,
+						FString::Printf(TEXT("Slot '%s' has tag '%s', which preset '%s' does not give it"), *Pair.Key.ToString(), *TagName.ToString(), *Preset->Name));
+				}
+			}
+		}
+
+		return Report;
+	}
+
+	bool WriteReport(const FString& Filename, const FString& ContentPath, const TArray<FMeshReport>& Reports, int32 NumErrors, int32 NumWarnings)
+	{
+		FString Json;
+		TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("path"), ContentPath);
+		Writer->WriteValue(TEXT("meshes"), Reports.Num());
+		Writer->WriteValue(TEXT("errors"), NumErrors);
+		Writer->WriteValue(TEXT("warnings"), NumWarnings);
+
+		Writer->WriteArrayStart(TEXT("issues"));
+		for (const FMeshReport& Report : Reports)
+		{
+			for (const FIssue& Issue : Report.Issues)
+			{
+				Writer->WriteObjectStart();
+				Writer->WriteValue(TEXT("mesh"), Report.MeshPath);
+				Writer->WriteValue(TEXT("severity"), FString(Issue.bError ? TEXT("error") : TEXT("warning")));
+				Writer->WriteValue(TEXT("check"), FString(Issue.Check));
+				if (!Issue.SlotName.IsNone())
+				{
+					Writer->WriteValue(TEXT("slot"), Issue.SlotName.ToString());
+				}
+				if (!Issue.TagName.IsNone())
+				{
+					Writer->WriteValue(TEXT("tag"), Issue.TagName.ToString());
+				}
+				if (!Report.PresetName.IsEmpty())
+				{
+					Writer->WriteValue(TEXT("preset"), Report.PresetName);
+				}
+				Writer->WriteValue(TEXT("message"), Issue.Message);
+				Writer->WriteObjectEnd();
+			}
+		}
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		return FFileHelper::SaveStringToFile(Json, *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	}
+}
+#endif
+
+UMaterialTagValidateCommandlet::UMaterialTagValidateCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Check the material tag data of every skeletal mesh under a content path and write a JSON report");
+	HelpUsage = TEXT("-run=MaterialTagValidate -Path=/Game/Characters [-Report=<file>] [-WarningsAsErrors] [-MaxInFlight=32] [-BatchSize=64]");
+}
+
+int32 UMaterialTagValidateCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString ContentPath;
+	if (!FParse::Value(*Params, TEXT("Path="), ContentPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("MaterialTagValidateCommandlet: Missing -Path. Usage: %s"), *HelpUsage);
+		return 1;
+	}
+
+	FString ReportPath = FPaths::ProjectSavedDir() / TEXT("MaterialTagPlugin") / TEXT("MaterialTagValidation.json");
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+	ReportPath = FPaths::ConvertRelativePathToFull(ReportPath);
+
+	const bool bWarningsAsErrors = FParse::Param(*Params, TEXT("WarningsAsErrors"));
+	int32 MaxInFlight = 32;
+	FParse::Value(*Params, TEXT("MaxInFlight="), MaxInFlight);
+	int32 BatchSize = 64;
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+
+	// Presets are resolved as meshes arrive; index them and build the match index up front
+	FMaterialTagPresetDatabase::Get().WarmUp();
+
+	// Read-only pass: nothing is saved
+	FMaterialTagAssetPipeline Pipeline(MaxInFlight, BatchSize, false);
+	const TArray<FName> PackageNames = Pipeline.FindPackages(ContentPath, USkeletalMesh::StaticClass());
+
+	FPresetResolver Presets;
+	TArray<TFuture<FMeshReport>> Pending;
+	const bool bLoadedAll = Pipeline.Run(PackageNames, [&Pending, &Presets](UPackage& Package)
+	{
+		TArray<UObject*> Objects;
+		GetObjectsWithPackage(&Package, Objects, false);
+		for (UObject* Object : Objects)
+		{
+			USkeletalMesh* Mesh = Cast<USkeletalMesh>(Object);
+			const UMaterialTagAssetUserData* UserData = Mesh ? Mesh->GetAssetUserData<UMaterialTagAssetUserData>() : nullptr;
+			if (!UserData) continue;
+
+			Pending.Add(Async(EAsyncExecution::ThreadPool, [Snapshot = TakeSnapshot(*Mesh, *UserData, Presets)]()
+			{
+				return ValidateMesh(Snapshot);
+			}));
+		}
+		return false;
+	});
+
+	const double WaitStartTime = FPlatformTime::Seconds();
+	TArray<FMeshReport> Reports;
+	Reports.Reserve(Pending.Num());
+	for (TFuture<FMeshReport>& Future : Pending)
+	{
+		Reports.Add(Future.Get());
+	}
+	const double WaitSeconds = FPlatformTime::Seconds() - WaitStartTime;
+
+	// Completion order depends on the loader; sort so reports diff cleanly
+	Reports.Sort([](const FMeshReport& A, const FMeshReport& B) { return A.MeshPath < B.MeshPath; });
+
+	int32 NumErrors = 0;
+	int32 NumWarnings = 0;
+	for (const FMeshReport& Report : Reports)
+	{
+		for (const FIssue& Issue : Report.Issues)
+		{
+			if (Issue.bError)
+			{
+				NumErrors++;
+				UE_LOG(LogTemp, Error, TEXT("MaterialTagValidateCommandlet: %s: [%s] %s"), *Report.MeshPath, Issue.Check, *Issue.Message);
+			}
+			else
+			{
+				NumWarnings++;
+				UE_LOG(LogTemp, Warning, TEXT("MaterialTagValidateCommandlet: %s: [%s] %s"), *Report.MeshPath, Issue.Check, *Issue.Message);
+			}
+		}
+	}
+
+	const bool bReportWritten = WriteReport(ReportPath, ContentPath, Reports, NumErrors, NumWarnings);
+	if (!bReportWritten)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MaterialTagValidateCommandlet: Could not write %s"), *ReportPath);
+	}
+
+	Pipeline.LogTimings(TEXT("MaterialTagValidateCommandlet"));
+	UE_LOG(LogTemp, Display, TEXT("MaterialTagValidateCommandlet: %d tagged mesh(es) checked, %d error(s), %d warning(s); waited %.2fs for checks. Report: %s"),
+		Reports.Num(), NumErrors, NumWarnings, WaitSeconds, *ReportPath);
+
+	const bool bFailed = NumErrors > 0 || (bWarningsAsErrors && NumWarnings > 0);
+	return (bLoadedAll && bReportWritten && !bFailed) ? 0 : 1;
+#else
+	return 1;
+#endif
+}
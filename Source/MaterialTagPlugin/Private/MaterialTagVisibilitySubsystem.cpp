@@ -0,0 +1,327 @@
+#include "MaterialTagVisibilitySubsystem.h"
+#include "MaterialTagAssetUserData.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+void UMaterialTagVisibilitySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UWorld* World = GetWorld();
+	check(World);
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UMaterialTagVisibilitySubsystem::OnActorSpawned));
+	ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &UMaterialTagVisibilitySubsystem::OnActorDestroyed));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UMaterialTagVisibilitySubsystem::OnLevelAddedToWorld);
+}
+
+void UMaterialTagVisibilitySubsystem::OnWorldComponentsUpdated(UWorld& InWorld)
+{
+	Super::OnWorldComponentsUpdated(InWorld);
+
+	// Editor and preview worlds never begin play; this runs for every world once its actors' components exist
+	RegisterAllComponents();
+}
+
+void UMaterialTagVisibilitySubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		// Engine spelling
+		World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	ActorSpawnedHandle.Reset();
+	ActorDestroyedHandle.Reset();
+	LevelAddedHandle.Reset();
+
+	Components.Empty();
+	PendingComponents.Empty();
+	SpawnedActors.Empty();
+	DirtyComponents.Empty();
+	Super::Deinitialize();
+}
+
+bool UMaterialTagVisibilitySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Editor preview worlds too, so the skeletal mesh editor can show toggles
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE
+		|| WorldType == EWorldType::Editor || WorldType == EWorldType::EditorPreview;
+}
+
+TStatId UMaterialTagVisibilitySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMaterialTagVisibilitySubsystem, STATGROUP_Tickables);
+}
+
+bool UMaterialTagVisibilitySubsystem::RegisterComponent(USkeletalMeshComponent* Component)
+{
+	if (!Component || Component->GetWorld() != GetWorld()) return false;
+
+	USkeletalMesh* Mesh = Component->GetSkeletalMeshAsset();
+	const UMaterialTagAssetUserData* UserData = Mesh ? Mesh->GetAssetUserData<UMaterialTagAssetUserData>() : nullptr;
+	if (!UserData) return false;
+
+	FComponentState& State = Components.FindOrAdd(Component);
+	State.UserData = UserData;
+	PendingComponents.Remove(Component);
+	DirtyComponents.Add(Component);
+	return true;
+}
+
+void UMaterialTagVisibilitySubsystem::UnregisterComponent(USkeletalMeshComponent* Component)
+{
+	Components.Remove(Component);
+	PendingComponents.Remove(Component);
+	DirtyComponents.Remove(Component);
+}
+
+void UMaterialTagVisibilitySubsystem::RegisterAllComponents()
+{
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		TrackActor(*It);
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("MaterialTagVisibilitySubsystem: %d tagged skeletal mesh component(s) registered, %d waiting for tag data"),
+		Components.Num(), PendingComponents.Num());
+}
+
+void UMaterialTagVisibilitySubsystem::TrackComponent(USkeletalMeshComponent* Component)
+{
+	if (!Component || Component->GetWorld() != GetWorld() || RegisterComponent(Component))
+	{
+		return;
+	}
+	PendingComponents.Add(Component, Component->GetSkeletalMeshAsset());
+}
+
+void UMaterialTagVisibilitySubsystem::TrackActor(AActor* Actor)
+{
+	if (!Actor) return;
+
+	TInlineComponentArray<USkeletalMeshComponent*> MeshComponents;
+	Actor->GetComponents(MeshComponents);
+	for (USkeletalMeshComponent* Component : MeshComponents)
+	{
+		TrackComponent(Component);
+	}
+}
+
+void UMaterialTagVisibilitySubsystem::UpdatePendingComponents()
+{
+	// Only a mesh change can give a pending component tag data, so unchanged ones cost a pointer compare
+	for (auto It = PendingComponents.CreateIterator(); It; ++It)
+	{
+		USkeletalMeshComponent* Component = It.Key().Get();
+		if (!Component)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		const USkeletalMesh* Mesh = Component->GetSkeletalMeshAsset();
+		if (Mesh == It.Value().Get())
+		{
+			continue;
+		}
+		It.Value() = Mesh;
+
+		const UMaterialTagAssetUserData* UserData = Mesh ? Mesh->GetAssetUserData<UMaterialTagAssetUserData>() : nullptr;
+		if (UserData)
+		{
+			Components.FindOrAdd(Component).UserData = UserData;
+			DirtyComponents.Add(Component);
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UMaterialTagVisibilitySubsystem::OnActorSpawned(AActor* Actor)
+{
+	// Deferred spawns and construction scripts add components after this fires; look at the actor on the next tick
+	SpawnedActors.Add(Actor);
+}
+
+void UMaterialTagVisibilitySubsystem::OnActorDestroyed(AActor* Actor)
+{
+	if (!Actor) return;
+
+	TInlineComponentArray<USkeletalMeshComponent*> MeshComponents;
+	Actor->GetComponents(MeshComponents);
+	for (USkeletalMeshComponent* Component : MeshComponents)
+	{
+		UnregisterComponent(Component);
+	}
+}
+
+void UMaterialTagVisibilitySubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* InWorld)
+{
+	if (!Level || InWorld != GetWorld()) return;
+
+	// Streamed-in actors are loaded, not spawned
+	for (AActor* Actor : Level->Actors)
+	{
+		TrackActor(Actor);
+	}
+}
+
+void UMaterialTagVisibilitySubsystem::SetTagEnabled(FGameplayTag Tag, bool bEnabled)
+{
+	if (!Tag.IsValid()) return;
+
+	// Only record the change; the next Tick re-evaluates every component once
+	if (bEnabled)
+	{
+		bAllDirty |= DisabledTags.RemoveTag(Tag);
+	}
+	else if (!DisabledTags.HasTagExact(Tag))
+	{
+		DisabledTags.AddTag(Tag);
+		bAllDirty = true;
+	}
+}
+
+void UMaterialTagVisibilitySubsystem::SetTagEnabledForComponent(USkeletalMeshComponent* Component, FGameplayTag Tag, bool bEnabled)
+{
+	if (!Tag.IsValid()) return;
+
+	FComponentState* State = Components.Find(Component);
+	if (!State)
+	{
+		if (!RegisterComponent(Component)) return;
+		State = Components.Find(Component);
+	}
+
+	if (bEnabled)
+	{
+		if (!State->DisabledTags.RemoveTag(Tag)) return;
+	}
+	else
+	{
+		if (State->DisabledTags.HasTagExact(Tag)) return;
+		State->DisabledTags.AddTag(Tag);
+	}
+	DirtyComponents.Add(Component);
+}
+
+bool UMaterialTagVisibilitySubsystem::IsTagEnabled(FGameplayTag Tag) const
+{
+	return !DisabledTags.HasTagExact(Tag);
+}
+
+void UMaterialTagVisibilitySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	for (const TWeakObjectPtr<AActor>& Actor : SpawnedActors)
+	{
+		TrackActor(Actor.Get());
+	}
+	SpawnedActors.Reset();
+	UpdatePendingComponents();
+
+	if (!bAllDirty && DirtyComponents.Num() == 0)
+	{
+		return;
+	}
+
+	// A crowd shares a handful of meshes: compute each mesh's world-wide hidden slots once per pass
+	TMap<const UMaterialTagAssetUserData*, TBitArray<>> WorldHiddenByMesh;
+
+	// Components whose mesh was swapped go back to pending, which picks up the new mesh's data if it has any
+	auto Requeue = [this](USkeletalMeshComponent* Component)
+	{
+		if (Component)
+		{
+			PendingComponents.Add(Component, nullptr);
+		}
+	};
+
+	if (bAllDirty)
+	{
+		for (auto It = Components.CreateIterator(); It; ++It)
+		{
+			USkeletalMeshComponent* Component = It.Key().Get();
+			if (!Component || !ApplyComponent(Component, It.Value(), WorldHiddenByMesh))
+			{
+				Requeue(Component);
+				It.RemoveCurrent();
+			}
+		}
+	}
+	else
+	{
+		for (const TWeakObjectPtr<USkeletalMeshComponent>& WeakComponent : DirtyComponents)
+		{
+			FComponentState* State = Components.Find(WeakComponent);
+			if (!State) continue;
+
+			USkeletalMeshComponent* Component = WeakComponent.Get();
+			if (!Component || !ApplyComponent(Component, *State, WorldHiddenByMesh))
+			{
+				Requeue(Component);
+				Components.Remove(WeakComponent);
+			}
+		}
+	}
+
+	bAllDirty = false;
+	DirtyComponents.Reset();
+}
+
+bool UMaterialTagVisibilitySubsystem::ApplyComponent(USkeletalMeshComponent* Component, FComponentState& State, TMap<const UMaterialTagAssetUserData*, TBitArray<>>& WorldHiddenByMesh)
+{
+	// Drop components whose mesh was swapped out; registering again picks up the new mesh's data
+	const UMaterialTagAssetUserData* UserData = State.UserData.Get();
+	const USkeletalMesh* Mesh = Component->GetSkeletalMeshAsset();
+	if (!UserData || !Mesh || UserData->GetOuter() != Mesh)
+	{
+		return false;
+	}
+
+	const TBitArray<>* WorldHidden = WorldHiddenByMesh.Find(UserData);
+	if (!WorldHidden)
+	{
+		WorldHidden = &WorldHiddenByMesh.Add(UserData, UserData->SlotsMatchingAnyTag(DisabledTags));
+	}
+
+	TBitArray<> Hidden = *WorldHidden;
+	if (!State.DisabledTags.IsEmpty())
+	{
+		Hidden.CombineWithBitwiseOR(UserData->SlotsMatchingAnyTag(State.DisabledTags), EBitwiseOperatorFlags::MaxSize);
+	}
+
+	// Compare against what the component's LODs already hide (a missing entry is shown), so a freshly
+	// registered component with nothing disabled costs no write and no render state recreation
+	bool bChanged = false;
+	for (FSkelMeshComponentLODInfo& LODInfo : Component->LODInfo)
+	{
+		TArray<bool>& HiddenMaterials = LODInfo.HiddenMaterials;
+		const int32 NumSlots = FMath::Max(Hidden.Num(), HiddenMaterials.Num());
+		for (int32 Slot = 0; Slot < NumSlots; Slot++)
+		{
+			const bool bHide = Slot < Hidden.Num() && Hidden[Slot];
+			const bool bHidden = HiddenMaterials.IsValidIndex(Slot) && HiddenMaterials[Slot];
+			if (bHide != bHidden)
+			{
+				HiddenMaterials.SetNumZeroed(FMath::Max(HiddenMaterials.Num(), Hidden.Num()));
+				HiddenMaterials[Slot] = bHide;
+				bChanged = true;
+			}
+		}
+	}
+
+	// Recreate the render state once; the new mesh object picks the lists up
+	if (bChanged)
+	{
+		Component->MarkRenderStateDirty();
+	}
+	return true;
+}
@@ -0,0 +1,177 @@
+#include "MaterialTagPresetTokenizer.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MaterialTagPresetTokenizerTest
+{
+	/** Forwards to the real allocator and counts allocations made on one thread while installed */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner)
+			: Inner(InInner)
+			, ThreadId(FPlatformTLS::GetCurrentThreadId())
+		{
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			Record();
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			Record();
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			Inner->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return Inner->QuantizeSize(Count, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return Inner->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return Inner->GetDescriptiveName();
+		}
+
+		int32 GetNumAllocations() const { return NumAllocations.load(); }
+
+	private:
+		void Record()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+			{
+				NumAllocations++;
+			}
+		}
+
+		FMalloc* Inner;
+		uint32 ThreadId;
+		std::atomic<int32> NumAllocations{ 0 };
+	};
+
+	/** Heap allocations and reallocations Func makes on the calling thread */
+	int32 CountAllocations(TFunctionRef<void()> Func)
+	{
+		FMalloc* const Original = GMalloc;
+		FCountingMalloc Counting(Original);
+
+		GMalloc = &Counting;
+		Func();
+		GMalloc = Original;
+
+		return Counting.GetNumAllocations();
+	}
+
+	/** NumSections sections of LinesPerSection slot lines each, with the blank lines and comments real files have */
+	FString MakeIni(int32 NumSections, int32 LinesPerSection)
+	{
+		FString Text;
+		for (int32 Section = 0; Section < NumSections; Section++)
+		{
+			Text.Appendf(TEXT("; Character %d\n[SK_Mesh_%d]\nSlotCount=%d\n"), Section, Section, LinesPerSection);
+			for (int32 Line = 0; Line < LinesPerSection; Line++)
+			{
+				Text.Appendf(TEXT("  Slot_%d = M_Slot_%d  \r\n"), Line, Line);
+			}
+			Text += TEXT("MaterialTag.Equipment=M_Slot_0, M_Slot_1 ,M_Slot_2\n\n");
+		}
+		return Text;
+	}
+
+	struct FTokenCounts
+	{
+		int32 NumSections = 0;
+		int32 NumKeyValues = 0;
+		int32 NumListItems = 0;
+	};
+
+	/** Tokenize Text the way the section index does: only each section's name is copied out */
+	FTokenCounts Tokenize(const FString& Text, TArray<FString>& OutSectionNames)
+	{
+		FTokenCounts Counts;
+		FMaterialTagPresetTokenizer Tokenizer(Text);
+		FMaterialTagPresetTokenizer::FToken Token;
+		while (Tokenizer.Next(Token))
+		{
+			if (Token.Type == FMaterialTagPresetTokenizer::ETokenType::Section)
+			{
+				Counts.NumSections++;
+				OutSectionNames.Emplace(Token.Name);
+				continue;
+			}
+
+			Counts.NumKeyValues++;
+			FMaterialTagPresetTokenizer::ForEachListItem(Token.Value, [&Counts](FStringView Item)
+			{
+				Counts.NumListItems++;
+			});
+		}
+		return Counts;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaterialTagPresetTokenizerAllocationTest, "MaterialTagPlugin.Presets.TokenizerAllocations",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMaterialTagPresetTokenizerAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace MaterialTagPresetTokenizerTest;
+
+	constexpr int32 NumSections = 4;
+	const FString ShortIni = MakeIni(NumSections, 10);
+	const FString LongIni = MakeIni(NumSections, 5000);
+	const FString WideIni = MakeIni(NumSections * 8, 10);
+
+	auto Measure = [](const FString& Text, FTokenCounts& OutCounts)
+	{
+		TArray<FString> SectionNames;
+		SectionNames.Reserve(64);
+		const int32 NumAllocations = CountAllocations([&Text, &SectionNames, &OutCounts]()
+		{
+			OutCounts = Tokenize(Text, SectionNames);
+		});
+		return NumAllocations;
+	};
+
+	FTokenCounts ShortCounts;
+	FTokenCounts LongCounts;
+	FTokenCounts WideCounts;
+	const int32 ShortAllocations = Measure(ShortIni, ShortCounts);
+	const int32 LongAllocations = Measure(LongIni, LongCounts);
+	const int32 WideAllocations = Measure(WideIni, WideCounts);
+
+	// The tokenizer must still see every line
+	TestEqual(TEXT("Sections in the long INI"), LongCounts.NumSections, NumSections);
+	TestEqual(TEXT("Key/value lines in the long INI"), LongCounts.NumKeyValues, NumSections * (5000 + 2));
+	TestEqual(TEXT("List items in the long INI"), LongCounts.NumListItems, NumSections * (5000 + 1 + 3));
+
+	// Only the section names kept by the caller allocate: 500x the lines, same allocations; 8x the sections, more
+	TestTrue(TEXT("Allocations are bounded by the section count"), ShortAllocations <= NumSections);
+	TestEqual(TEXT("Allocations do not grow with lines per section"), LongAllocations, ShortAllocations);
+	TestTrue(TEXT("Allocations grow with sections"), WideAllocations > ShortAllocations && WideAllocations <= NumSections * 8);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MaterialTagApplyCommandlet.generated.h"
+
+/**
+ * Tags every skeletal mesh under a content path from the preset database, without opening the editor UI.
+ *
+ * Each mesh gets UMaterialTagAssetUserData (added if missing, with an entry per material slot) and is
+ * matched to a preset with the same scoring as auto-match. Matches below
+ * FMaterialTagPresetDatabase::AutoMatchConfidence are left alone. The matched preset's tags are then
+ * added to its slots, as dragging every pill would. Tags already present are kept.
+ * Existing data whose slot entries had to be reconciled with the mesh on load is saved too, match or not.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd Project.uproject -run=MaterialTagApply -Path=/Game/Characters
+ *     [-DryRun]          match and report, save nothing
+ *     [-MaxInFlight=32]  outstanding async package loads
+ *     [-BatchSize=64]    packages per save / garbage collection batch
+ *
+ * Returns non-zero if the path is missing, there is no preset file, or any package failed to load or save.
+ */
+UCLASS()
+class MATERIALTAGPLUGIN_API UMaterialTagApplyCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMaterialTagApplyCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -6,6 +6,45 @@
 #include "Engine/SkeletalMesh.h"
 #include "MaterialTagAssetUserData.generated.h"
 
+struct FMaterialTagPreset;
+struct FMaterialTagPresetCandidate;
+
+/**
+ * Flat per-mesh tag table for runtime queries: one bit row per material slot (mesh material order),
+ * bits indexed by gameplay tag net index, with every explicit tag's parents set as well.
+ * A slot "carries T or a child of T" exactly when bit T is set in its row.
+ */
+struct FMaterialTagSlotBitTable
+{
+	/** NumSlots rows of WordsPerSlot words each */
+	TArray<uint64> Words;
+	int32 NumSlots = 0;
+	int32 WordsPerSlot = 0;
+
+	/** UGameplayTagsManager net index hash the rows were built against */
+	uint32 NetIndexHash = 0;
+	bool bValid = false;
+
+	/** MaterialSlotTags as the rows were built from: each entry's slot name and tag count, and all tags in entry order */
+	TArray<FName> SourceSlotNames;
+	TArray<int32> SourceTagCounts;
+	TArray<FGameplayTag> SourceTags;
+
+	const uint64* GetRow(int32 Slot) const { return Words.GetData() + Slot * WordsPerSlot; }
+};
+
+#if WITH_EDITOR
+/** One tagged material slot as recorded in the mesh's asset registry tags */
+struct FMaterialTagRegistrySlot
+{
+	/** Index into the mesh's material list */
+	int32 SlotIndex = INDEX_NONE;
+	FName SlotName;
+	/** Tags that resolve in the current tag table */
+	FGameplayTagContainer Tags;
+};
+#endif
+
 /**
  * Wrapper for a single FGameplayTag.
  * Used inside TArray so each tag gets its own independent tag picker in the editor.
@@ -53,22 +92,51 @@ struct MATERIALTAGPLUGIN_API FMaterialSlotTagEntry
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Tags")
 	TArray<FGameplayTagEntry> GameplayTags;
 
-	/** Helper: build an FGameplayTagContainer from all entries */
-	FGameplayTagContainer ToContainer() const
+	/**
+	 * Helper: all entries as an FGameplayTagContainer, cached.
+	 * The cache remembers the tags it was built from and is rebuilt whenever GameplayTags differs, so writes
+	 * that bypass InvalidateContainer (Blueprint, direct C++) never see a stale container. Game thread only.
+	 */
+	const FGameplayTagContainer& ToContainer() const
 	{
-		FGameplayTagContainer Container;
-		for (const FGameplayTagEntry& Entry : GameplayTags)
+		checkSlow(IsInGameThread());
+
+		bool bStale = bContainerDirty || CachedSourceTags.Num() != GameplayTags.Num();
+		for (int32 Index = 0; !bStale && Index < GameplayTags.Num(); Index++)
+		{
+			bStale = CachedSourceTags[Index] != GameplayTags[Index].Tag;
+		}
+
+		if (bStale)
 		{
-			if (Entry.Tag.IsValid())
+			CachedSourceTags.Reset(GameplayTags.Num());
+			CachedContainer.Reset(GameplayTags.Num());
+			for (const FGameplayTagEntry& Entry : GameplayTags)
 			{
-				Container.AddTagFast(Entry.Tag);
+				CachedSourceTags.Add(Entry.Tag);
+				if (Entry.Tag.IsValid())
+				{
+					CachedContainer.AddTagFast(Entry.Tag);
+				}
 			}
+			bContainerDirty = false;
 		}
-		return Container;
+		return CachedContainer;
 	}
 
+	/** Force a rebuild on the next ToContainer(), e.g. after the tag table was reloaded */
+	void InvalidateContainer() const { bContainerDirty = true; }
+
 	/** Helper: number of tag entries */
 	int32 Num() const { return GameplayTags.Num(); }
+
+private:
+	/** Transient; rebuilt from GameplayTags on the first ToContainer() after a change */
+	mutable FGameplayTagContainer CachedContainer;
+
+	/** GameplayTags as of the last rebuild, compared on every ToContainer() */
+	mutable TArray<FGameplayTag> CachedSourceTags;
+	mutable bool bContainerDirty = true;
 };
 
 /**
@@ -100,7 +168,8 @@ public:
 	UMaterialTagAssetUserData();
 
 	/**
-	 * If true, automatically selects the preset matching the mesh name.
+	 * If true, automatically selects the preset whose name is most similar to the mesh name.
+	 * Nothing is selected if no preset is similar enough.
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preset")
 	bool bAutoMatchPreset = false;
@@ -135,15 +204,31 @@ public:
 	void PopulateFromMesh();
 
 	/**
-	 * Ensure all mesh material slots have entries (adds missing ones, keeps existing).
+	 * Ensure all mesh material slots have entries (adds missing ones, keeps existing) in mesh order.
+	 * Returns immediately if the mesh's slot names are unchanged since the last reconcile.
+	 * Returns true if the entries or the stored slot layout changed, i.e. the asset should be saved;
+	 * data saved before the layout was stored reports true once, even if its entries were already in order.
 	 */
-	void EnsureAllSlotsPopulated();
+	bool EnsureAllSlotsPopulated();
+
+	/** True if a reconcile changed the entries or the stored slot layout since this object was loaded or created, including the one PostLoad runs */
+	bool HasReconciledSlotsSinceLoad() const { return bReconciledSinceLoad; }
 
 	/**
-	 * Get all tags for a specific material slot (collected from all matching entries).
+	 * Add the preset's tags to the entries of the slots it lists, as dragging every pill would.
+	 * Tags already on a slot are kept; slots without an entry are skipped. Returns the number of tags added.
 	 */
-	UFUNCTION(BlueprintCallable, Category = "Material Tags")
-	FGameplayTagContainer GetTagsForSlot(FName SlotName) const;
+	int32 ApplyPresetTags(const FMaterialTagPreset& Preset);
+
+	/**
+	 * Get all tags for a specific material slot.
+	 * Returns the entry's cached container (or an empty one), so repeated queries allocate nothing.
+	 */
+	const FGameplayTagContainer& GetTagsForSlot(FName SlotName) const;
+
+	/** Blueprint wrapper for GetTagsForSlot */
+	UFUNCTION(BlueprintCallable, Category = "Material Tags", meta=(DisplayName="Get Tags For Slot"))
+	FGameplayTagContainer K2_GetTagsForSlot(FName SlotName) const;
 
 	/**
 	 * Check if a slot has any tags assigned.
@@ -151,22 +236,98 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Material Tags")
 	bool HasTagsForSlot(FName SlotName) const;
 
+	/**
+	 * Get every material slot's tags in one call, in the mesh's material order.
+	 * Slots without an entry get an empty container.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Material Tags")
+	TArray<FGameplayTagContainer> GetAllSlotTags() const;
+
+	/**
+	 * Bitmask over material slots (mesh material order) whose tags include Tag or one of its children.
+	 * Answered from the compiled bit table with one word test per slot; no container is touched.
+	 */
+	TBitArray<> SlotsMatchingTag(const FGameplayTag& Tag) const;
+
+	/** Bitmask over material slots whose tags include any of Tags or their children */
+	TBitArray<> SlotsMatchingAnyTag(const FGameplayTagContainer& Tags) const;
+
+#if WITH_EDITOR
+	/** Mesh asset registry tag: number of material slots with at least one tag */
+	static const FName TaggedSlotCountRegistryTag;
+
+	/** Mesh asset registry tag: distinct MaterialTags used on any slot, sorted, comma separated */
+	static const FName MaterialTagsRegistryTag;
+
+	/** Hidden mesh asset registry tag: every tagged slot, one "SlotIndex<TAB>SlotName<TAB>TagA,TagB" line each */
+	static const FName SlotTagsRegistryTag;
+
+	/** Decode a SlotTagsRegistryTag value; tags missing from the tag table are dropped */
+	static void ParseSlotTagsRegistryValue(const FString& Value, TArray<FMaterialTagRegistrySlot>& OutSlots);
+
+	/**
+	 * Summaries added to the owning mesh's asset registry tags when it is saved,
+	 * so searches and tools can find tagged meshes without loading them.
+	 */
+	void GetMeshAssetRegistryTags(TArray<UObject::FAssetRegistryTag>& OutTags) const;
+#endif
+
+	/** Drop the slot lookup index and every entry's cached container; call after changing MaterialSlotTags from C++ */
+	void MarkSlotTagsDirty();
+
 	/** Returns list of mesh names from the preset INI (for GetOptions dropdown) */
 	UFUNCTION()
 	TArray<FString> GetPresetMeshNames() const;
 
+	/** PostLoad only touches this object; mesh-dependent work is deferred until the mesh has loaded */
+	virtual bool IsPostLoadThreadSafe() const override { return true; }
+
 #if WITH_EDITOR
+	/**
+	 * Run EnsureAllSlotsPopulated for user data whose PostLoad ran off the game thread or before
+	 * its mesh finished loading. Game thread only; called when package loads complete.
+	 */
+	static void FlushDeferredSlotReconciles();
+
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
 	virtual void PostLoad() override;
 #endif
 
-private:
-	/** Load preset info text for the given mesh name from the INI */
+	/** Load preset info text for the selected preset from the preset database */
 	void UpdatePresetInfo();
 
-	/** Auto-match: find the best preset name matching the owning mesh */
+private:
+	/** Auto-match: pick the best-scoring preset for the owning mesh, if it clears the confidence threshold */
 	void AutoMatchPresetFromMesh();
 
-	/** Get the path to the preset INI file */
-	static FString GetPresetIniPath();
+	/** Select the top candidate if it clears FMaterialTagPresetDatabase::AutoMatchConfidence. Returns true if it was selected. */
+	bool ApplyAutoMatch(const FString& MeshName, const TArray<FMaterialTagPresetCandidate>& Candidates);
+
+	/** Entry for a slot through the slot index, rebuilding the index if it is stale. Null if the slot has no entry. */
+	const FMaterialSlotTagEntry* FindSlotEntry(FName SlotName) const;
+
+	/** Slot name -> index of its first entry in MaterialSlotTags. Transient, rebuilt on first lookup after a change. */
+	mutable TMap<FName, int32> SlotIndex;
+	mutable int32 SlotIndexEntryCount = 0;
+	mutable bool bSlotIndexDirty = true;
+
+	/** Slot bit table, recompiled on the first query after a change. Game thread only. */
+	const FMaterialTagSlotBitTable& GetSlotBitTable() const;
+
+	/** Transient, rebuilt by GetSlotBitTable when invalidated, when the tag net indices change or when MaterialSlotTags no longer matches its source */
+	mutable FMaterialTagSlotBitTable SlotBitTable;
+
+	/** True if MaterialSlotTags still holds the names and tags SlotBitTable was built from */
+	bool SlotBitTableMatchesSlotTags() const;
+
+	/** Hash of the mesh's material slot names and the entries' slot names as of the last reconcile */
+	UPROPERTY()
+	uint32 SlotLayoutHash = 0;
+
+	/** Set when EnsureAllSlotsPopulated changes anything; transient */
+	bool bReconciledSinceLoad = false;
+
+	/** Order-sensitive hash of the mesh slot names followed by the entry slot names, stable across sessions */
+	static uint32 ComputeSlotLayoutHash(const TArray<FSkeletalMaterial>& Materials, const TArray<FMaterialSlotTagEntry>& Entries);
 };
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MaterialTagExportCommandlet.generated.h"
+
+/**
+ * Writes every tagged mesh's slot tags to one manifest file for the mod pipeline (format in MaterialTagManifest.h).
+ *
+ * Reads the MaterialTagSlotTags asset registry values, so no package is loaded. Meshes saved before
+ * the plugin published those values are missing until they are re-saved (e.g. by -run=MaterialTagApply).
+ *
+ * Exports are incremental: a cache next to the manifest (<manifest>.cache) remembers each package's
+ * saved hash, slot tag hash and record location. Packages whose hashes are unchanged have their
+ * records copied from the previous manifest byte for byte; only new or changed meshes are re-encoded.
+ *
+ * Copied records keep their string ids, so an incremental export starts from the previous string
+ * table and only ever adds to it: slot and tag names no mesh uses any more stay in the file. The
+ * cache records how many strings went unused; once that passes a quarter of the table, the next
+ * export is a full one and writes a table with only the names in use.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd Project.uproject -run=MaterialTagExport
+ *     [-Output=<file>]   default: Saved/MaterialTagPlugin/MaterialTagManifest.bin
+ *     [-Path=/Game/...]  only export meshes under this content path
+ *     [-Full]            ignore the cache and re-encode every mesh
+ *
+ * Returns non-zero if the manifest could not be written.
+ */
+UCLASS()
+class MATERIALTAGPLUGIN_API UMaterialTagExportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMaterialTagExportCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MaterialTagGeneratePresetsCommandlet.generated.h"
+
+/**
+ * Writes a MaterialTagPresets.ini from the tags already on skeletal meshes, so presets can be
+ * refreshed from the tagged content instead of maintained by hand.
+ *
+ * Every mesh under the path with tagged Material Tag Data becomes one [MeshName] section:
+ * SlotCount and Slot_N from the mesh's material slots, then one Tag=SlotA, SlotB line per tag.
+ * Sections are sorted by name, tag lines by tag and slots by slot index, so re-running on
+ * unchanged content produces an identical file. When two meshes share a name the one with the
+ * lowest path is kept, matching the database's first-section-wins rule.
+ *
+ * Meshes load through the async pipeline; each section is formatted on the thread pool while
+ * the next packages load.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd Project.uproject -run=MaterialTagGeneratePresets -Path=/Game/Characters
+ *     [-Output=<file>]   default: Saved/MaterialTagPlugin/MaterialTagPresets.ini
+ *     [-MaxInFlight=32] [-BatchSize=64]
+ *
+ * The output is not copied over the plugin's preset file; review the diff and copy it in.
+ * Returns non-zero if a package failed to load or the file could not be written.
+ */
+UCLASS()
+class MATERIALTAGPLUGIN_API UMaterialTagGeneratePresetsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMaterialTagGeneratePresetsCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MaterialTagImportDumpCommandlet.generated.h"
+
+/**
+ * Builds presets from JSON dumps of the retail game's skeletal meshes (FSkeletalMaterial::GameplayTagContainer),
+ * as extracted with UAssetToolRivals.
+ *
+ * Expected dump shape; a top-level array of meshes is accepted too, and unknown members are skipped:
+ *   { "Meshes": [ { "Name": "SK_...", "Materials": [ { "MaterialSlotName": "...", "GameplayTagContainer": [ "Tag.A", ... ] } ] } ] }
+ * "ObjectName", "SkeletalMaterials", "SlotName" and "GameplayTags" are read as aliases, and a tag
+ * container may be an object with a "GameplayTags" array, whose entries may be { "TagName": "..." } objects.
+ *
+ * Dumps are streamed (FMaterialTagJsonSaxReader), never loaded whole. Identical slot layouts are
+ * stored and formatted once and shared by every mesh that uses them, so memory grows with the number
+ * of distinct layouts plus one name per mesh, not with the size of the dumps. Meshes without tags are skipped;
+ * when a name appears twice, the first mesh read wins.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd Project.uproject -run=MaterialTagImportDump -Input=<dump.json or directory of *.json>
+ *     [-Output=<file>]   default: Saved/MaterialTagPlugin/MaterialTagPresets.ini
+ *     [-Compile]         also write the compiled preset blob for the INI; to the database's compiled
+ *                        preset path when -Output is the plugin's preset INI, else next to the output as .bin
+ *
+ * Returns non-zero if a dump could not be parsed or an output could not be written.
+ */
+UCLASS()
+class MATERIALTAGPLUGIN_API UMaterialTagImportDumpCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMaterialTagImportDumpCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -3,9 +3,28 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+struct FFileChangeData;
+
 class FMaterialTagPluginModule : public IModuleInterface
 {
 public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+#if WITH_EDITOR
+	/** Directory watcher callback for the plugin Config folder */
+	void OnPresetDirectoryChanged(const TArray<FFileChangeData>& FileChanges);
+
+	/** Folder being watched for preset edits */
+	FString WatchedPresetDirectory;
+
+	FDelegateHandle PresetDirectoryWatcherHandle;
+
+	/** UObject::FAssetRegistryTag::OnGetExtraObjectTags binding that adds material tag summaries to skeletal meshes */
+	FDelegateHandle ExtraObjectTagsHandle;
+
+	/** FCoreUObjectDelegates::OnEndLoadPackage binding that flushes deferred slot reconciles */
+	FDelegateHandle EndLoadPackageHandle;
+#endif
 };
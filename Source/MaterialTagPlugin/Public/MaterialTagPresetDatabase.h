@@ -0,0 +1,344 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/UniquePtr.h"
+#include "Delegates/Delegate.h"
+#include "Async/Future.h"
+#include "GameplayTagContainer.h"
+#include <atomic>
+
+class FMaterialTagPresetBlob;
+class FMaterialTagPresetMatcher;
+struct FFileStatData;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** One "Tag=SlotA, SlotB" line of a preset section */
+struct MATERIALTAGPLUGIN_API FMaterialTagPresetTag
+{
+	/** Tag name as written in the INI */
+	FName TagName;
+
+	/** Tag resolved when the preset was loaded; invalid if the name isn't a registered gameplay tag */
+	FGameplayTag Tag;
+
+	/** Slot names the tag applies to, in INI order */
+	TArray<FName> Slots;
+};
+
+/**
+ * Parsed contents of a single [MeshName] section in MaterialTagPresets.ini.
+ * Names are interned and tags resolved once at load, so the UI never hashes strings per frame or per drop.
+ *
+ * Section format:
+ *   SlotCount=N
+ *   Slot_0=SlotName
+ *   ...
+ *   MaterialTag.Some.Tag=SlotA, SlotB
+ */
+struct MATERIALTAGPLUGIN_API FMaterialTagPreset
+{
+	/** Section name as written in the INI */
+	FString Name;
+
+	/** Full ordered slot list (Slot_N keys), sized by SlotCount */
+	TArray<FName> Slots;
+
+	/** Tag lines in INI order; a repeated tag replaces the earlier line's slots */
+	TArray<FMaterialTagPresetTag> Tags;
+
+	/** Slot name -> valid tags (reverse of Tags) */
+	TMap<FName, TArray<FGameplayTag>> SlotToTags;
+
+	/** Hash of the section's header and body text; unchanged hash means the record can be reused on reload */
+	uint32 ContentHash = 0;
+
+	/** Find a tag line by name */
+	const FMaterialTagPresetTag* FindTag(FName TagName) const;
+
+	/** Add a tag line, replacing the slots of an existing line with the same name */
+	FMaterialTagPresetTag& AddTag(FName TagName);
+
+	/** Resolve every tag line against the gameplay tag table, warn once about unknown tags and rebuild SlotToTags */
+	void ResolveTags();
+};
+
+/** A preset scored against a mesh name by FMaterialTagPresetDatabase::RankPresets */
+struct FMaterialTagPresetCandidate
+{
+	FString Name;
+
+	/** Trigram similarity in [0, 1]; 1 for an exact (case-insensitive) name match */
+	float Score = 0.0f;
+};
+
+/** Result of a non-blocking preset lookup */
+enum class EMaterialTagPresetLookup : uint8
+{
+	/** The preset is loaded and returned */
+	Found,
+	/** Presets are loaded but have no such section */
+	NotFound,
+	/** Neither the preset INI nor the shard directory exists */
+	NoPresetFile,
+	/** The lookup needs a parse or disk read; a worker is doing it and OnPresetsChanged will report the section */
+	Pending,
+};
+
+/**
+ * Process-wide cache of the preset INI.
+ * The file is read once and indexed by section; a section's body is parsed into an
+ * FMaterialTagPreset the first time it is looked up. The file is only re-read when its
+ * timestamp or size changes. Lookups re-stat it at most once every RestatIntervalSeconds,
+ * or on the next lookup after RequestReload, which the editor calls from a watcher on the
+ * Config folder. All accessors are thread-safe.
+ *
+ * Whenever the INI is (re)parsed it is also compiled, on a worker, into a binary blob under Intermediate/.
+ * Later loads memory-map that blob instead of parsing text, as long as it was compiled from
+ * an INI with the same timestamp and size.
+ *
+ * Without a monolithic INI, presets are read from the per-character shard directory instead:
+ * only the manifest of section names is read up front, and a shard's body is loaded the
+ * first time one of its presets is looked up.
+ *
+ * On reload, sections whose content hash is unchanged keep their parsed record; only edited
+ * sections are re-parsed, and OnPresetsChanged reports which ones changed.
+ *
+ * The blocking accessors may read from disk and are meant for worker threads and commandlets.
+ * UI code uses the Try* accessors, which only answer from memory and defer everything else
+ * to the thread pool.
+ */
+class MATERIALTAGPLUGIN_API FMaterialTagPresetDatabase
+{
+public:
+	static FMaterialTagPresetDatabase& Get();
+
+	/** Get the path to the preset INI file */
+	static FString GetPresetIniPath();
+
+	/**
+	 * Get the path to the per-character shard directory, used when the monolithic INI does not exist.
+	 * Shards are preset INIs named by 7-digit character ID (e.g. 1014001.ini).
+	 */
+	static FString GetPresetShardDirectory();
+
+	/** Get the path to the shard manifest: one "SectionName=ShardFile.ini" line per preset */
+	static FString GetPresetShardManifestPath();
+
+	/** Get the path to the compiled preset blob */
+	static FString GetCompiledPresetPath();
+
+	/** Case-folded lookup key for a section name, as used in OnPresetsChanged */
+	static FString FoldSectionName(FStringView SectionName);
+
+	/** Append a section body as ParseSection reads it: SlotCount, Slot_N, then one "Tag=SlotA, SlotB" line per entry in the given order */
+	static void AppendSectionBody(FString& Out, TConstArrayView<FName> Slots, TConstArrayView<TPair<FName, TArray<FName>>> Tags);
+
+	/** Content hash of a section from its name and the text between its header line and the next header */
+	static uint32 HashSection(const FString& SectionName, FStringView Body);
+
+	/** Broadcast on the game thread with the folded names of sections that were edited, added, removed or finished loading */
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnPresetsChanged, const TSet<FString>& /*ChangedSections*/);
+	FOnPresetsChanged& OnPresetsChanged() { return PresetsChangedEvent; }
+
+	FMaterialTagPresetDatabase();
+	~FMaterialTagPresetDatabase();
+
+	/** True if the preset INI or shard directory exists on disk. Blocking. */
+	bool HasPresetFile();
+
+	/** All section names in file order. Blocking. */
+	TArray<FString> GetPresetNames();
+
+	/** Find a preset by section name (case-insensitive). Returns null if there is no such section. Blocking. */
+	TSharedPtr<const FMaterialTagPreset> FindPreset(const FString& PresetName);
+
+	/** FindPreset on the thread pool */
+	TFuture<TSharedPtr<const FMaterialTagPreset>> FindPresetAsync(const FString& PresetName);
+
+	/** GetPresetNames on the thread pool */
+	TFuture<TArray<FString>> GetPresetNamesAsync();
+
+	/**
+	 * Pick the preset for a mesh: exact name (ignoring case), then either name containing the other,
+	 * then a shared 7-digit character ID. Returns an empty string if nothing matches. Blocking.
+	 */
+	FString MatchPreset(const FString& MeshName);
+
+	/** MatchPreset on the thread pool */
+	TFuture<FString> MatchPresetAsync(const FString& MeshName);
+
+	/** Minimum RankPresets score auto-match accepts without review */
+	static constexpr float AutoMatchConfidence = 0.4f;
+
+	/**
+	 * Score presets by trigram similarity to the mesh name and return the best MaxResults, best first.
+	 * Unlike MatchPreset this tells skin variants that share a character ID apart. Blocking.
+	 */
+	TArray<FMaterialTagPresetCandidate> RankPresets(const FString& MeshName, int32 MaxResults);
+
+	/** RankPresets on the thread pool */
+	TFuture<TArray<FMaterialTagPresetCandidate>> RankPresetsAsync(const FString& MeshName, int32 MaxResults);
+
+	/** Load the preset source and build the match index now rather than on the first lookup. Returns the number of presets. Blocking. */
+	int32 WarmUp();
+
+	/** Game thread only. Answer from memory, or start loading the section on a worker and return Pending. */
+	EMaterialTagPresetLookup TryFindPreset(const FString& PresetName, TSharedPtr<const FMaterialTagPreset>& OutPreset);
+
+	/** Game thread only. Copy the loaded section names if available, and refresh them in the background either way. */
+	bool TryGetPresetNames(TArray<FString>& OutNames);
+
+	/** Game thread only. MatchPreset from memory; Pending if the names or the match index aren't built yet (use MatchPresetAsync). */
+	EMaterialTagPresetLookup TryMatchPreset(const FString& MeshName, FString& OutPresetName);
+
+	/** Game thread only. RankPresets from memory; Pending if the names or the match index aren't built yet (use RankPresetsAsync). */
+	EMaterialTagPresetLookup TryRankPresets(const FString& MeshName, int32 MaxResults, TArray<FMaterialTagPresetCandidate>& OutCandidates);
+
+	/** Game thread only. Re-check the preset source on a worker, ignoring the re-stat interval, and broadcast OnPresetsChanged for anything that changed. */
+	void RequestReload();
+
+	/** Seconds during which lookups trust the last stat of the preset source unless RequestReload was called */
+	static constexpr double RestatIntervalSeconds = 2.0;
+
+private:
+	/** Character range of one section's body within FileText or a shard's text (header line excluded) */
+	struct FSectionSpan
+	{
+		FString Name;
+		int32 ShardIndex;
+		int32 Begin;
+		int32 End;
+		uint32 ContentHash;
+	};
+
+	/** One per-character preset file in the shard directory */
+	struct FShard
+	{
+		FString Path;
+		FString Text;
+		FDateTime Timestamp;
+		int64 Size = INDEX_NONE;
+		bool bLoaded = false;
+	};
+
+	/** FindPreset body. Caller must hold Lock. */
+	TSharedPtr<const FMaterialTagPreset> FindPresetLocked(const FString& Key);
+
+	/** Match index over SectionNames, built on first use. Caller must hold Lock. */
+	const FMaterialTagPresetMatcher& GetMatcherLocked();
+
+	/** Hop to the game thread and broadcast OnPresetsChanged; clears the in-flight marker for CompletedLookup (or the reload if empty) */
+	void BroadcastOnGameThread(TSet<FString>&& ChangedSections, const FString& CompletedLookup);
+
+	/** Stat whichever preset source is active: the INI, else the shard manifest/directory. */
+	static bool StatSource(FFileStatData& OutStat, bool& bOutShards);
+
+	/** True if no loaded shard changed on disk since it was read. Caller must hold Lock. */
+	bool AreLoadedShardsCurrent() const;
+
+	/** Stat the preset source, at most once per RestatIntervalSeconds unless a reload was requested, and re-index it if it changed since the last load. Caller must hold Lock. */
+	void RefreshIfStale();
+
+	/** Game thread only. RefreshIfStale on a worker, then broadcast OnPresetsChanged; no-op while one is in flight. */
+	void StartRefresh();
+
+	/** Content hash of a section in the current index/blob, loading its shard if needed. Caller must hold Lock. */
+	bool FindSectionHash(const FString& FoldedName, uint32& OutHash);
+
+	/** Find a section's span, loading its shard if needed. Caller must hold Lock. */
+	const FSectionSpan* FindSpan(const FString& FoldedName);
+
+	/** Read the shard manifest (or index every shard if there is none). Caller must hold Lock. */
+	void BuildShardManifest();
+
+	/** Read one shard and index its sections. Caller must hold Lock. */
+	void LoadShard(int32 ShardIndex, bool bRecordNames);
+
+	/** Text a span points into. Caller must hold Lock. */
+	const FString& GetSpanText(const FSectionSpan& Span) const;
+
+	/** Build the section index for FileText (ShardIndex == INDEX_NONE) or a shard in one pass over its headers. Caller must hold Lock. */
+	void IndexText(int32 ShardIndex, bool bRecordNames);
+
+	/** Parse a single section's body into a preset record. Caller must hold Lock. */
+	TSharedPtr<const FMaterialTagPreset> ParseSection(const FSectionSpan& Span) const;
+
+	/** ParseSection without resolving the tags, from any text. Thread-safe. */
+	static TSharedRef<FMaterialTagPreset> ParseSectionBody(const FString& Name, uint32 ContentHash, FStringView Body);
+
+	/** Map the compiled blob if it exists and was built from the current INI. Caller must hold Lock. */
+	bool OpenCompiledBlob();
+
+	/**
+	 * Write the compiled blob for the next load on a worker, from a copy of the INI text. Sections already parsed
+	 * are reused; the rest are parsed on the worker and not kept, so lookups still parse on demand. Caller must hold Lock.
+	 */
+	void StartCompileBlob();
+
+	/** Drop everything loaded from the previous INI, including the blob mapping. Caller must hold Lock. */
+	void Reset();
+
+	FCriticalSection Lock;
+
+	/** Set once the preset source has been stat'd and indexed at least once */
+	bool bLoaded = false;
+
+	bool bFileExists = false;
+
+	/** FPlatformTime::Seconds() of the last stat of the preset source */
+	double LastStatTime = 0.0;
+
+	/** Set by RequestReload; the next RefreshIfStale stats the source even inside the interval */
+	std::atomic<bool> bRestatRequested{ false };
+
+	FDateTime LoadedTimestamp;
+	int64 LoadedSize = INDEX_NONE;
+
+	/** Memory-mapped compiled blob; when valid, FileText and SectionIndex are empty */
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TUniquePtr<FMaterialTagPresetBlob> Blob;
+
+	/** Last blob compile; a reload while it runs leaves compiling to a later load */
+	TFuture<void> CompileTask;
+
+	/** True when presets come from the shard directory instead of the monolithic INI */
+	bool bUsingShards = false;
+
+	/** Shard files, in manifest order */
+	TArray<FShard> Shards;
+
+	/** Folded section name -> shard index, from the manifest */
+	TMap<FString, int32> ShardManifest;
+
+	/** Whole INI contents; section spans index into this */
+	FString FileText;
+
+	/** Section names in file order */
+	TArray<FString> SectionNames;
+
+	/** Auto-match index over SectionNames; kept across reloads that don't change the names */
+	TUniquePtr<FMaterialTagPresetMatcher> Matcher;
+
+	/** Folded section name -> body range, for the INI and every loaded shard */
+	TMap<FString, FSectionSpan> SectionIndex;
+
+	/** Folded section name -> parsed record, filled on first lookup */
+	TMap<FString, TSharedPtr<const FMaterialTagPreset>> ParsedSections;
+
+	/** Folded names that were looked up but not found, so a reload that adds them is reported */
+	TSet<FString> MissingSections;
+
+	/** Folded names of sections that changed in a reload but have not been broadcast yet */
+	TSet<FString> PendingChangedSections;
+
+	FOnPresetsChanged PresetsChangedEvent;
+
+	/** Game thread only: folded names with a TryFindPreset worker in flight */
+	TSet<FString> PendingLookups;
+
+	/** Game thread only: a RequestReload worker is in flight */
+	bool bReloadInFlight = false;
+};
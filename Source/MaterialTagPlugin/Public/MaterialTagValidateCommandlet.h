@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MaterialTagValidateCommandlet.generated.h"
+
+/**
+ * Checks the material tag data of every skeletal mesh under a content path, for use as a build gate.
+ *
+ * Errors:
+ *   MissingSlot        an entry names a material slot the mesh doesn't have (e.g. renamed on reimport)
+ *   UnknownTag         a tag is not registered with UGameplayTagsManager
+ *   DuplicateSlot      two entries for the same slot; only the first is used
+ *   PresetSlotMissing  the matched preset tags a slot the mesh doesn't have
+ * Warnings:
+ *   EmptyTag           a tag entry left empty
+ *   PresetNotFound     the selected preset is not in the preset database
+ *   PresetMismatch     a slot's tags differ from the matched preset's
+ *
+ * The preset is the one selected on the data, or else the auto-match if it clears the confidence threshold.
+ * Meshes load through the async pipeline; each one is checked on the thread pool while the next ones load.
+ * Presets are resolved on the game thread, once per distinct name, and handed to the checks with the mesh.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd Project.uproject -run=MaterialTagValidate -Path=/Game/Characters
+ *     [-Report=<file>]      JSON report, default: Saved/MaterialTagPlugin/MaterialTagValidation.json
+ *     [-WarningsAsErrors]   fail on warnings too
+ *     [-MaxInFlight=32] [-BatchSize=64]
+ *
+ * Returns non-zero if any error was found (or any warning, with -WarningsAsErrors) or a package failed to load.
+ */
+UCLASS()
+class MATERIALTAGPLUGIN_API UMaterialTagValidateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMaterialTagValidateCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
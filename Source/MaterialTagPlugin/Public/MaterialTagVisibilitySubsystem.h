@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "MaterialTagVisibilitySubsystem.generated.h"
+
+class AActor;
+class ULevel;
+class USkeletalMesh;
+class USkeletalMeshComponent;
+class UMaterialTagAssetUserData;
+
+/**
+ * Hides material slots by MaterialTag the way the game does, for editor previews and test maps.
+ *
+ * Keeps a registry of skeletal mesh components whose mesh carries UMaterialTagAssetUserData.
+ * Components are picked up without any call from game code: the world is scanned once its components
+ * are registered (editor and preview worlds never begin play), and actors spawned or streamed in later
+ * are added as they appear. A component whose mesh has no tag data yet, such as a preview component
+ * that gets its mesh after spawning, is registered once it has one. Destroyed actors are dropped.
+ * Tag enable/disable requests only record the change; once per frame the subsystem recomputes
+ * each affected component's hidden slots from the mesh's compiled slot bit table and writes them
+ * to every LOD, with a single render-state update per component no matter how many requests came in.
+ *
+ * A slot is hidden while any of its tags (or their parents) is disabled, either world-wide or
+ * for that component.
+ */
+UCLASS()
+class MATERIALTAGPLUGIN_API UMaterialTagVisibilitySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldComponentsUpdated(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickableInEditor() const override { return true; }
+
+	/**
+	 * Track a component so tag requests apply to it. Ignored if its mesh has no material tag data.
+	 * Returns true if the component is registered.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Material Tags")
+	bool RegisterComponent(USkeletalMeshComponent* Component);
+
+	/** Stop tracking a component until its actor is spawned or scanned again; its slots keep whatever visibility was last applied */
+	UFUNCTION(BlueprintCallable, Category = "Material Tags")
+	void UnregisterComponent(USkeletalMeshComponent* Component);
+
+	/** Register every skeletal mesh component in the world that carries material tag data */
+	UFUNCTION(BlueprintCallable, Category = "Material Tags")
+	void RegisterAllComponents();
+
+	/** Show (enabled) or hide (disabled) the slots carrying Tag on every registered component. Applied next frame. */
+	UFUNCTION(BlueprintCallable, Category = "Material Tags")
+	void SetTagEnabled(FGameplayTag Tag, bool bEnabled);
+
+	/** SetTagEnabled for a single component, on top of the world-wide state. Applied next frame. */
+	UFUNCTION(BlueprintCallable, Category = "Material Tags")
+	void SetTagEnabledForComponent(USkeletalMeshComponent* Component, FGameplayTag Tag, bool bEnabled);
+
+	/** True if Tag is not disabled world-wide */
+	UFUNCTION(BlueprintCallable, Category = "Material Tags")
+	bool IsTagEnabled(FGameplayTag Tag) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FComponentState
+	{
+		TWeakObjectPtr<const UMaterialTagAssetUserData> UserData;
+
+		/** Tags disabled for this component only */
+		FGameplayTagContainer DisabledTags;
+	};
+
+	/** Recompute one component's hidden slots and write them if they differ from its LODs'; returns false if its mesh changed */
+	bool ApplyComponent(USkeletalMeshComponent* Component, FComponentState& State, TMap<const UMaterialTagAssetUserData*, TBitArray<>>& WorldHiddenByMesh);
+
+	/** Register a component now, or keep it pending until its mesh carries tag data */
+	void TrackComponent(USkeletalMeshComponent* Component);
+
+	/** TrackComponent for every skeletal mesh component of an actor */
+	void TrackActor(AActor* Actor);
+
+	/** Register pending components whose mesh changed since they were last checked */
+	void UpdatePendingComponents();
+
+	void OnActorSpawned(AActor* Actor);
+	void OnActorDestroyed(AActor* Actor);
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* InWorld);
+
+	TMap<TWeakObjectPtr<USkeletalMeshComponent>, FComponentState> Components;
+
+	/** Actors spawned since the last tick, scanned once their construction has finished */
+	TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+
+	/** Skeletal mesh components whose mesh has no tag data, with the mesh they had when last checked */
+	TMap<TWeakObjectPtr<USkeletalMeshComponent>, TWeakObjectPtr<const USkeletalMesh>> PendingComponents;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle LevelAddedHandle;
+
+	/** Tags disabled on every component */
+	FGameplayTagContainer DisabledTags;
+
+	/** World-wide state changed since the last pass: every component is re-evaluated */
+	bool bAllDirty = false;
+
+	/** Components with their own requests or newly registered since the last pass */
+	TSet<TWeakObjectPtr<USkeletalMeshComponent>> DirtyComponents;
+};